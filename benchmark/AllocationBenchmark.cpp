@@ -0,0 +1,129 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <GenericFactory/Allocation.h>
+#include <GenericFactory/GenericFactory_impl.h>
+
+#include <vector>
+
+#include "./BenchmarkClasses.h"
+
+using genericfactory::GenericFactory;
+using genericfactory::MonotonicArena;
+using genericfactory::ObjectPool;
+
+namespace {
+// Objects every thread creates and destroys per iteration.
+const int kBatchSize = 256;
+}  // namespace
+
+static void BM_ChurnHeap(benchmark::State& state) {  // NOLINT
+  std::vector<Plugin*> objs(kBatchSize);
+  for (auto _ : state) {
+    for (Plugin*& obj : objs)
+      obj = GenericFactory<Plugin>::create("Shader_Cached");
+    for (Plugin* obj : objs)
+      delete obj;
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_ChurnHeap)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ChurnArena(benchmark::State& state) {  // NOLINT
+  MonotonicArena arena;
+  for (auto _ : state) {
+    for (int i = 0; i < kBatchSize; ++i) {
+      benchmark::DoNotOptimize(
+            GenericFactory<Plugin>::create("Shader_Cached", &arena));
+    }
+    arena.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_ChurnArena)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ChurnPool(benchmark::State& state) {  // NOLINT
+  ObjectPool pool;
+  std::vector<Plugin*> objs(kBatchSize);
+  for (auto _ : state) {
+    for (Plugin*& obj : objs)
+      obj = GenericFactory<Plugin>::create("Shader_Cached", &pool);
+    for (Plugin* obj : objs)
+      GenericFactory<Plugin>::release(obj, &pool);
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_ChurnPool)->ThreadRange(1, 16)->UseRealTime();
+
+// One lookup and one block for the whole batch.
+static void BM_ChurnCreateMany(benchmark::State& state) {  // NOLINT
+  std::vector<Plugin*> objs(kBatchSize);
+  for (auto _ : state) {
+    GenericFactory<Plugin>::createMany("Shader_Cached", kBatchSize,
+                                       objs.data());
+    GenericFactory<Plugin>::destroyMany(objs.data(), kBatchSize);
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_ChurnCreateMany)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ChurnCreateManyArena(benchmark::State& state) {  // NOLINT
+  MonotonicArena arena;
+  std::vector<Plugin*> objs(kBatchSize);
+  for (auto _ : state) {
+    GenericFactory<Plugin>::createMany("Shader_Cached", kBatchSize,
+                                       objs.data(), &arena);
+    arena.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_ChurnCreateManyArena)->ThreadRange(1, 16)->UseRealTime();
+
+// Walks the objects after creating them (cache friendly if they are back to
+// back).
+static void BM_IterateCreated(benchmark::State& state) {  // NOLINT
+  std::vector<Plugin*> objs(state.range(0));
+  for (Plugin*& obj : objs)
+    obj = GenericFactory<Plugin>::create("Shader_Cached");
+  for (auto _ : state) {
+    for (Plugin* obj : objs)
+      static_cast<Shader*>(obj)->setPasses(2);
+  }
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  for (Plugin* obj : objs)
+    delete obj;
+}
+BENCHMARK(BM_IterateCreated)->Arg(100000);
+
+static void BM_IterateCreatedMany(benchmark::State& state) {  // NOLINT
+  std::vector<Plugin*> objs(state.range(0));
+  GenericFactory<Plugin>::createMany("Shader_Cached", objs.size(),
+                                     objs.data());
+  for (auto _ : state) {
+    for (Plugin* obj : objs)
+      static_cast<Shader*>(obj)->setPasses(2);
+  }
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  GenericFactory<Plugin>::destroyMany(objs.data(), objs.size());
+}
+BENCHMARK(BM_IterateCreatedMany)->Arg(100000);
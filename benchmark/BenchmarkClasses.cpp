@@ -0,0 +1,141 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "./BenchmarkClasses.h"
+
+#include <GenericFactory/GenericFactory_impl.h>
+
+#include <string>
+#include <utility>
+
+
+namespace {
+template<int... I>
+void registerParams(std::integer_sequence<int, I...>) {
+  (genericfactory::GenericFactory<Plugin>::registerProperty(
+        "param" + std::to_string(I),
+        &Material::setParam<I>,
+        &Material::getParam<I>), ...);
+}
+
+// Registers Nest<T, 1> to Nest<T, N>.
+template<typename T, int N>
+struct RegisterNested {
+  static void registerAll() {
+    genericfactory::GenericFactory<Node>::registerClass<Layer<T> >();
+    RegisterNested<Layer<T>, N - 1>::registerAll();
+  }
+};
+template<typename T>
+struct RegisterNested<T, 0> {
+  static void registerAll() { }
+};
+}  // namespace
+
+void Shader::registerProperties() {
+  static bool m_lock(true);
+  if (!m_lock)
+    return;
+  m_lock = false;
+  genericfactory::GenericFactory<Plugin>::registerProperty(
+        "source",
+        &Shader::setSource,
+        &Shader::getSource);
+  genericfactory::GenericFactory<Plugin>::registerProperty(
+        "passes",
+        &Shader::setPasses,
+        &Shader::getPasses);
+  genericfactory::GenericFactory<Plugin>::registerProperty(
+        "defines",
+        &Shader::setDefines,
+        &Shader::getDefines);
+}
+
+void Mesh::registerProperties() {
+  static bool m_lock(true);
+  if (!m_lock)
+    return;
+  m_lock = false;
+  genericfactory::GenericFactory<Plugin>::registerProperty(
+        "vertices", &Mesh::vertices);
+  genericfactory::GenericFactory<Plugin>::registerProperty(
+        "scale", &Mesh::scale);
+}
+
+void Material::registerProperties() {
+  static bool m_lock(true);
+  if (!m_lock)
+    return;
+  m_lock = false;
+  registerParams(std::make_integer_sequence<int, kParams>());
+}
+
+namespace genericfactory {
+template<>
+char GenericFactory<Plugin>::registerAllForBase() {
+  GenericFactory<Plugin>::registerClass<Shader>();
+  GenericFactory<Plugin>::registerClass<Mesh>();
+  GenericFactory<Plugin>::registerClass<Cached<Shader> >();
+  GenericFactory<Plugin>::registerClass<Cached<Mesh> >();
+  GenericFactory<Plugin>::registerClass<Cached<Cached<Shader> > >();
+  GenericFactory<Plugin>::registerClass<Material>();
+  return 'y';
+}
+
+template<>
+char GenericFactory<Node>::registerAllForBase() {
+  RegisterNested<Node, kMaxNesting>::registerAll();
+  return 'y';
+}
+
+// Filled by the benchmarks.
+template<>
+char GenericFactory<Scratch>::registerAllForBase() {
+  return 'y';
+}
+
+template<>
+char GenericFactory<Sealed>::registerAllForBase() {
+  return 'y';
+}
+
+// Filled by BM_Startup.
+template<>
+char GenericFactory<Startup<false, 10> >::registerAllForBase() {
+  return 'y';
+}
+
+template<>
+char GenericFactory<Startup<true, 10> >::registerAllForBase() {
+  return 'y';
+}
+
+template<>
+char GenericFactory<Startup<false, 100> >::registerAllForBase() {
+  return 'y';
+}
+
+template<>
+char GenericFactory<Startup<true, 100> >::registerAllForBase() {
+  return 'y';
+}
+}  // namespace genericfactory
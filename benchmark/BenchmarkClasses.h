@@ -0,0 +1,213 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef BENCHMARKCLASSES_H_
+#define BENCHMARKCLASSES_H_
+
+#include <GenericFactory/GenericFactory_decl.h>
+#include <GenericFactory/FixedString.h>
+#include <GenericFactory/Property.h>
+
+#include <string>
+#include <utility>
+
+// Base of all benchmarked classes.
+struct Plugin {
+ public:
+  static constexpr genericfactory::FixedString name = "Plugin";
+  virtual ~Plugin() { }
+  virtual Plugin* create() const = 0;
+};
+struct Shader : public Plugin {
+ public:
+  static constexpr genericfactory::FixedString name = "Shader";
+  static void registerProperties();
+  virtual Shader* create() const {
+    return new Shader();
+  }
+
+  void setSource(std::string source) {
+    m_Source = source;
+  }
+  std::string getSource() const {
+    return m_Source;
+  }
+  void setPasses(int passes) {
+    m_Passes = passes;
+  }
+  int getPasses() const {
+    return m_Passes;
+  }
+  // Same as source, moved in and returned by reference.
+  void setDefines(std::string&& defines) {
+    m_Defines = std::move(defines);
+  }
+  const std::string& getDefines() const {
+    return m_Defines;
+  }
+
+ private:
+  std::string m_Source;
+  std::string m_Defines;
+  int m_Passes = 1;
+};
+struct Mesh : public Plugin {
+ public:
+  static constexpr genericfactory::FixedString name = "Mesh";
+  static void registerProperties();
+  virtual Mesh* create() const {
+    return new Mesh();
+  }
+
+  // Registered as data members.
+  int vertices = 0;
+  float scale = 1.0f;
+};
+// A object with kParams properties ("param0", ...), configured from a
+// template object in CreateBenchmark.cpp.
+struct Material : public Plugin {
+ public:
+  static constexpr genericfactory::FixedString name = "Material";
+  static constexpr int kParams = 20;
+  static void registerProperties();
+  virtual Material* create() const {
+    return new Material();
+  }
+  template<int I>
+  void setParam(float value) {
+    m_Params[I] = value;
+  }
+  template<int I>
+  float getParam() const {
+    return m_Params[I];
+  }
+
+ private:
+  float m_Params[kParams] = { };
+};
+template<typename T>
+struct Cached : public T {
+ public:
+  static constexpr auto name = T::name + "_Cached";
+  virtual Cached<T>* create() const {
+    return new Cached<T>();
+  }
+};
+// Bases of the classes used to grow registries (see RegistryBenchmark.cpp),
+// so the Plugin registry stays small. Classes are created in the Node
+// registry and registered in the Scratch one.
+struct Node {
+ public:
+  static constexpr genericfactory::FixedString name = "Node";
+  virtual ~Node() { }
+};
+struct Scratch {
+ public:
+  static constexpr genericfactory::FixedString name = "Scratch";
+  virtual ~Scratch() { }
+};
+// Base of a registry grown like the Node one and then frozen.
+struct Sealed {
+ public:
+  virtual ~Sealed() { }
+};
+// Stamps out registry entries at runtime: registering it again after
+// changing name adds another class, without compiling one type per entry.
+template<typename Base>
+struct Generated : public Base {
+ public:
+  static std::string name;
+};
+template<typename Base>
+std::string Generated<Base>::name;
+// Base of the classes registered by BM_Startup, one registry per mode and
+// number of classes.
+template<bool kLazy, int kCount>
+struct Startup {
+ public:
+  virtual ~Startup() { }
+};
+// The I-th of the plugin classes of Base ("Plugin_<I>"), every one is a type
+// of its own.
+template<typename Base, int I>
+struct StartupPlugin : public Base {
+ public:
+  static const std::string name;
+  static void registerProperties();
+  void setValue(int value) {
+    m_Value = value;
+  }
+  int getValue() const { return m_Value; }
+
+ private:
+  int m_Value = 0;
+};
+template<typename Base, int I>
+const std::string StartupPlugin<Base, I>::name = "Plugin_" + std::to_string(I);
+template<typename Base, int I>
+void StartupPlugin<Base, I>::registerProperties() {
+  static const char* const names[] = {
+    "p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7"
+  };
+  for (const char* name : names) {
+    genericfactory::GenericFactory<Base>::registerProperty(name,
+          &StartupPlugin<Base, I>::setValue,
+          &StartupPlugin<Base, I>::getValue);
+  }
+}
+// D<T>-style hierarchy, the names grow with every level.
+template<typename T>
+struct Layer : public T {
+ public:
+  static constexpr auto name = T::name + "_Layer";
+};
+// Layer<Layer<...<T> > > with N levels.
+template<typename T, int N>
+struct Nest {
+  typedef typename Nest<Layer<T>, N - 1>::type type;
+};
+template<typename T>
+struct Nest<T, 0> {
+  typedef T type;
+};
+// Deepest Nest<Node, N> that is registered.
+const int kMaxNesting = 32;
+
+namespace genericfactory {
+template<>
+char GenericFactory<Plugin>::registerAllForBase();
+template<>
+char GenericFactory<Node>::registerAllForBase();
+template<>
+char GenericFactory<Scratch>::registerAllForBase();
+template<>
+char GenericFactory<Sealed>::registerAllForBase();
+template<>
+char GenericFactory<Startup<false, 10> >::registerAllForBase();
+template<>
+char GenericFactory<Startup<true, 10> >::registerAllForBase();
+template<>
+char GenericFactory<Startup<false, 100> >::registerAllForBase();
+template<>
+char GenericFactory<Startup<true, 100> >::registerAllForBase();
+}  // namespace genericfactory
+#endif  // BENCHMARKCLASSES_H_
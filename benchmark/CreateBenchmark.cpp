@@ -0,0 +1,241 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <GenericFactory/GenericFactory_impl.h>
+#include <GenericFactory/Parallel.h>
+#include <GenericFactory/StaticFactory.h>
+
+#include <map>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <utility>
+#include <vector>
+
+#include "./BenchmarkClasses.h"
+
+using genericfactory::GenericFactory;
+
+namespace {
+// Mirrors the registry GenericFactory used before it was keyed by
+// std::string_view.
+std::map<std::string, Plugin*>& legacyMap() {
+  static std::map<std::string, Plugin*> m_Map = {
+    {"Shader", new Shader()},
+    {"Mesh", new Mesh()},
+    {"Shader_Cached", new Cached<Shader>()},
+    {"Mesh_Cached", new Cached<Mesh>()},
+    {"Shader_Cached_Cached", new Cached<Cached<Shader> >()}
+  };
+  return m_Map;
+}
+
+// The old creation path: the registry is passed by value and searched with
+// operator[].
+Plugin* legacyCreate(
+      const std::string& name,
+      std::map<std::string, Plugin*> reflectionMap) {
+  Plugin* creator = reflectionMap[name];
+  if (!creator)
+    return nullptr;
+  return creator->create();
+}
+}  // namespace
+
+static void BM_CreateLegacy(benchmark::State& state) {  // NOLINT
+  for (auto _ : state) {
+    Plugin* obj = legacyCreate("Shader_Cached", legacyMap());
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateLegacy);
+
+static void BM_CreateStdString(benchmark::State& state) {  // NOLINT
+  const std::string name("Shader_Cached");
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::create(name);
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateStdString);
+
+static void BM_CreateCharPtr(benchmark::State& state) {  // NOLINT
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateCharPtr);
+
+static void BM_CreateStringView(benchmark::State& state) {  // NOLINT
+  const std::string_view name("Shader_Cached");
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::create(name);
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateStringView);
+
+static void BM_CreateHashed(benchmark::State& state) {  // NOLINT
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::create<Cached<Shader>::name.hash()>();
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateHashed);
+
+static void BM_CreateById(benchmark::State& state) {  // NOLINT
+  const genericfactory::ClassId id =
+      GenericFactory<Plugin>::classId("Shader_Cached");
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::create(id);
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateById);
+
+namespace {
+typedef genericfactory::StaticFactory<Plugin, Shader, Mesh, Cached<Shader>,
+        Cached<Mesh>, Cached<Cached<Shader> > > StaticPlugins;
+}  // namespace
+
+static void BM_CreateStatic(benchmark::State& state) {  // NOLINT
+  const std::string_view name("Shader_Cached");
+  for (auto _ : state) {
+    Plugin* obj = StaticPlugins::create(name);
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateStatic);
+
+static void BM_CreateStaticHashed(benchmark::State& state) {  // NOLINT
+  for (auto _ : state) {
+    Plugin* obj = StaticPlugins::create<Cached<Shader>::name.hash()>();
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateStaticHashed);
+
+// Lookups dont lock, these should scale with the number of cores.
+static void BM_CreateThreaded(benchmark::State& state) {  // NOLINT
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CreateThreaded)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_FindPropertyThreaded(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+          GenericFactory<Plugin>::findProperty("passes", obj));
+  }
+  state.SetItemsProcessed(state.iterations());
+  delete obj;
+}
+BENCHMARK(BM_FindPropertyThreaded)->ThreadRange(1, 32)->UseRealTime();
+
+namespace {
+// The values of a configured Material, as a config would list them.
+const std::vector<std::pair<std::string, std::string> >& materialValues() {
+  static const std::vector<std::pair<std::string, std::string> > m_Values =
+      []() {
+    std::vector<std::pair<std::string, std::string> > values;
+    for (int i = 0; i < Material::kParams; ++i)
+      values.emplace_back("param" + std::to_string(i), std::to_string(i + 0.5));
+    return values;
+  }();
+  return m_Values;
+}
+}  // namespace
+
+// Creating a object with 20 properties set: create and set every property
+// from its string, copy a configured object or create its preset.
+static void BM_CreateThenSet(benchmark::State& state) {  // NOLINT
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::create("Material");
+    for (const auto& value : materialValues())
+      GenericFactory<Plugin>::setProperty(value.first, obj, value.second);
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateThenSet);
+
+static void BM_Clone(benchmark::State& state) {  // NOLINT
+  Plugin* configured = GenericFactory<Plugin>::create("Material");
+  for (const auto& value : materialValues())
+    GenericFactory<Plugin>::setProperty(value.first, configured, value.second);
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::clone(configured);
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+  delete configured;
+}
+BENCHMARK(BM_Clone);
+
+static void BM_CreatePreset(benchmark::State& state) {  // NOLINT
+  static const bool m_Registered = []() {
+    Plugin* configured = GenericFactory<Plugin>::create("Material");
+    for (const auto& value : materialValues())
+      GenericFactory<Plugin>::setProperty(value.first, configured,
+                                          value.second);
+    GenericFactory<Plugin>::registerPreset("Material_Configured", configured);
+    return true;
+  }();
+  benchmark::DoNotOptimize(m_Registered);
+  for (auto _ : state) {
+    Plugin* obj = GenericFactory<Plugin>::create("Material_Configured");
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreatePreset);
+
+// 10k objects with two properties each, Arg is the number of workers.
+static void BM_CreateParallel(benchmark::State& state) {  // NOLINT
+  std::vector<genericfactory::ObjectSpec> specs(10000);
+  for (std::size_t i = 0; i < specs.size(); ++i) {
+    specs[i].className = "Shader_Cached";
+    specs[i].properties = {{"passes", std::to_string(i % 8)},
+                           {"source", "void main() { }"}};
+  }
+  for (auto _ : state) {
+    for (Plugin* obj : genericfactory::createParallel<Plugin>(
+          specs, static_cast<unsigned>(state.range(0))))
+      delete obj;
+  }
+  state.SetItemsProcessed(state.iterations() * specs.size());
+}
+BENCHMARK(BM_CreateParallel)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
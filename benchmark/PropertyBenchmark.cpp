@@ -0,0 +1,286 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <GenericFactory/GenericFactory_impl.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "./BenchmarkClasses.h"
+
+using genericfactory::GenericFactory;
+using genericfactory::PropertyHandle;
+
+static void BM_SetPropertyByName(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const std::string value("42");
+  for (auto _ : state)
+    GenericFactory<Plugin>::setProperty("passes", obj, value);
+  delete obj;
+}
+BENCHMARK(BM_SetPropertyByName);
+
+static void BM_SetPropertyByHandle(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const std::string value("42");
+  const PropertyHandle<Plugin> passes =
+      GenericFactory<Plugin>::findProperty("passes", obj);
+  for (auto _ : state)
+    passes.set(obj, value);
+  delete obj;
+}
+BENCHMARK(BM_SetPropertyByHandle);
+
+static void BM_GetPropertyByName(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+          GenericFactory<Plugin>::getProperty("passes", obj));
+  }
+  delete obj;
+}
+BENCHMARK(BM_GetPropertyByName);
+
+static void BM_GetPropertyByHandle(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const PropertyHandle<Plugin> passes =
+      GenericFactory<Plugin>::findProperty("passes", obj);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(passes.get(obj));
+  delete obj;
+}
+BENCHMARK(BM_GetPropertyByHandle);
+
+static void BM_SetTypedPropertyByName(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  for (auto _ : state)
+    GenericFactory<Plugin>::setProperty<int>("passes", obj, 42);
+  delete obj;
+}
+BENCHMARK(BM_SetTypedPropertyByName);
+
+static void BM_GetTypedPropertyByName(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+          GenericFactory<Plugin>::getProperty<int>("passes", obj));
+  }
+  delete obj;
+}
+BENCHMARK(BM_GetTypedPropertyByName);
+
+static void BM_SetTypedPropertyById(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const genericfactory::PropertyId passes =
+      GenericFactory<Plugin>::propertyId("passes");
+  for (auto _ : state)
+    GenericFactory<Plugin>::setProperty<int>(passes, obj, 42);
+  delete obj;
+}
+BENCHMARK(BM_SetTypedPropertyById);
+
+static void BM_GetTypedPropertyById(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const genericfactory::PropertyId passes =
+      GenericFactory<Plugin>::propertyId("passes");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+          GenericFactory<Plugin>::getProperty<int>(passes, obj));
+  delete obj;
+}
+BENCHMARK(BM_GetTypedPropertyById);
+
+// Same as above for a std::string property.
+static void BM_SetStringPropertyByName(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const std::string value("void main() { }");
+  for (auto _ : state)
+    GenericFactory<Plugin>::setProperty("source", obj, value);
+  delete obj;
+}
+BENCHMARK(BM_SetStringPropertyByName);
+
+static void BM_GetStringPropertyByName(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  GenericFactory<Plugin>::setProperty("source", obj, "void main() { }");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+          GenericFactory<Plugin>::getProperty("source", obj));
+  }
+  delete obj;
+}
+BENCHMARK(BM_GetStringPropertyByName);
+
+static void BM_SetTypedStringPropertyByName(  // NOLINT
+      benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const std::string value("void main() { }");
+  for (auto _ : state)
+    GenericFactory<Plugin>::setProperty<std::string>("source", obj, value);
+  delete obj;
+}
+BENCHMARK(BM_SetTypedStringPropertyByName);
+
+// A 64 KiB string through a by value setter/getter ("source") and through
+// a setter taking std::string&& and a getter returning a reference
+// ("defines").
+static void BM_SetLargeString(  // NOLINT
+      benchmark::State& state, const char* propName) {
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const std::string value(64 * 1024, 'x');
+  for (auto _ : state)
+    GenericFactory<Plugin>::setProperty(propName, obj, value);
+  state.SetBytesProcessed(state.iterations() * value.size());
+  delete obj;
+}
+BENCHMARK_CAPTURE(BM_SetLargeString, ByValue, "source");
+BENCHMARK_CAPTURE(BM_SetLargeString, ByReference, "defines");
+
+static void BM_GetLargeString(  // NOLINT
+      benchmark::State& state, const char* propName) {
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const std::string value(64 * 1024, 'x');
+  GenericFactory<Plugin>::setProperty(propName, obj, value);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+          GenericFactory<Plugin>::getProperty(propName, obj));
+  }
+  state.SetBytesProcessed(state.iterations() * value.size());
+  delete obj;
+}
+BENCHMARK_CAPTURE(BM_GetLargeString, ByValue, "source");
+BENCHMARK_CAPTURE(BM_GetLargeString, ByReference, "defines");
+
+static void BM_SetTypedPropertyByHandle(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const PropertyHandle<Plugin> passes =
+      GenericFactory<Plugin>::findProperty("passes", obj);
+  for (auto _ : state)
+    passes.setValue<int>(obj, 42);
+  delete obj;
+}
+BENCHMARK(BM_SetTypedPropertyByHandle);
+
+static void BM_GetTypedPropertyByHandle(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+  const PropertyHandle<Plugin> passes =
+      GenericFactory<Plugin>::findProperty("passes", obj);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(passes.getValue<int>(obj));
+  delete obj;
+}
+BENCHMARK(BM_GetTypedPropertyByHandle);
+
+// The same on a data member: a store/load instead of a virtual call and a
+// call through a member function pointer.
+static void BM_SetTypedFieldByHandle(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Mesh_Cached");
+  const PropertyHandle<Plugin> vertices =
+      GenericFactory<Plugin>::findProperty("vertices", obj);
+  for (auto _ : state)
+    vertices.setValue<int>(obj, 42);
+  delete obj;
+}
+BENCHMARK(BM_SetTypedFieldByHandle);
+
+static void BM_GetTypedFieldByHandle(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Mesh_Cached");
+  const PropertyHandle<Plugin> vertices =
+      GenericFactory<Plugin>::findProperty("vertices", obj);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(vertices.getValue<int>(obj));
+  delete obj;
+}
+BENCHMARK(BM_GetTypedFieldByHandle);
+
+static void BM_SetTypedFieldByName(benchmark::State& state) {  // NOLINT
+  Plugin* obj = GenericFactory<Plugin>::create("Mesh_Cached");
+  for (auto _ : state)
+    GenericFactory<Plugin>::setProperty<int>("vertices", obj, 42);
+  delete obj;
+}
+BENCHMARK(BM_SetTypedFieldByName);
+
+// Copying a value between two objects: getter + setter vs memcpy.
+static void BM_CopyPropertyByHandle(benchmark::State& state) {  // NOLINT
+  Plugin* from = GenericFactory<Plugin>::create("Shader_Cached");
+  Plugin* to = GenericFactory<Plugin>::create("Shader_Cached");
+  const PropertyHandle<Plugin> passes =
+      GenericFactory<Plugin>::findProperty("passes", from);
+  for (auto _ : state)
+    passes.copy(from, to);
+  delete from;
+  delete to;
+}
+BENCHMARK(BM_CopyPropertyByHandle);
+
+static void BM_CopyFieldByHandle(benchmark::State& state) {  // NOLINT
+  Plugin* from = GenericFactory<Plugin>::create("Mesh_Cached");
+  Plugin* to = GenericFactory<Plugin>::create("Mesh_Cached");
+  const PropertyHandle<Plugin> vertices =
+      GenericFactory<Plugin>::findProperty("vertices", from);
+  for (auto _ : state)
+    vertices.copy(from, to);
+  delete from;
+  delete to;
+}
+BENCHMARK(BM_CopyFieldByHandle);
+
+static void BM_SetPropertiesLoop(benchmark::State& state) {  // NOLINT
+  std::vector<Plugin*> objs;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    objs.push_back(GenericFactory<Plugin>::create(
+          i % 2 ? "Shader" : "Shader_Cached"));
+  }
+  const std::string source("void main() { }");
+  const std::string passes("3");
+  for (auto _ : state) {
+    for (Plugin* obj : objs) {
+      GenericFactory<Plugin>::setProperty("source", obj, source);
+      GenericFactory<Plugin>::setProperty("passes", obj, passes);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  for (Plugin* obj : objs)
+    delete obj;
+}
+BENCHMARK(BM_SetPropertiesLoop)->Arg(1000)->Arg(100000);
+
+static void BM_SetPropertiesBatch(benchmark::State& state) {  // NOLINT
+  std::vector<Plugin*> objs;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    objs.push_back(GenericFactory<Plugin>::create(
+          i % 2 ? "Shader" : "Shader_Cached"));
+  }
+  const std::vector<std::pair<std::string, std::string> > values = {
+    {"source", "void main() { }"},
+    {"passes", "3"}
+  };
+  for (auto _ : state)
+    GenericFactory<Plugin>::setProperties(objs.data(), objs.size(), values);
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  for (Plugin* obj : objs)
+    delete obj;
+}
+BENCHMARK(BM_SetPropertiesBatch)->Arg(1000)->Arg(100000);
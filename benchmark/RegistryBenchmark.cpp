@@ -0,0 +1,288 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <GenericFactory/GenericFactory_impl.h>
+#include <GenericFactory/FixedString.h>
+#include <GenericFactory/LiteralStringList.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./BenchmarkClasses.h"
+
+using genericfactory::GenericFactory;
+
+namespace {
+// Registers Generated<Base> under the next free name ("Generated_<i>") and
+// returns the number of names registered so far.
+template<typename Base>
+std::size_t registerGenerated() {
+  static std::size_t m_Count = 0;
+  Generated<Base>::name = "Generated_" + std::to_string(m_Count);
+  GenericFactory<Base>::template registerClass<Generated<Base> >();
+  return ++m_Count;
+}
+
+// Registers classes until there are at least count of them. The registry
+// only grows, so benchmarks taking a size have to run with ascending sizes.
+template<typename Base>
+void growRegistry(std::size_t count) {
+  static std::size_t m_Size = 0;
+  while (m_Size < count)
+    m_Size = registerGenerated<Base>();
+}
+}  // namespace
+
+// Creating by name with 10 to 100k classes registered.
+static void BM_CreateAtRegistrySize(benchmark::State& state) {  // NOLINT
+  growRegistry<Node>(state.range(0));
+  const std::string name = "Generated_" + std::to_string(state.range(0) / 2);
+  for (auto _ : state) {
+    Node* obj = GenericFactory<Node>::create(name);
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK(BM_CreateAtRegistrySize)->RangeMultiplier(10)->Range(10, 100000);
+
+// Misses cost a hash and a probe, nothing is reported without a sink.
+static void BM_CreateMissAtRegistrySize(benchmark::State& state) {  // NOLINT
+  growRegistry<Node>(state.range(0));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(GenericFactory<Node>::create("NotRegistered"));
+}
+BENCHMARK(BM_CreateMissAtRegistrySize)
+    ->RangeMultiplier(10)->Range(10, 100000);
+
+static void BM_CreateThreadedAtRegistrySize(benchmark::State& state) {  // NOLINT
+  growRegistry<Node>(100000);
+  for (auto _ : state) {
+    Node* obj = GenericFactory<Node>::create("Generated_50000");
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CreateThreadedAtRegistrySize)
+    ->ThreadRange(1, 32)->UseRealTime();
+
+// The same lookups in a frozen registry of 100k classes.
+static void BM_CreateFrozen(benchmark::State& state) {  // NOLINT
+  static const genericfactory::RegistryMemory memory = []() {
+    growRegistry<Sealed>(100000);
+    return GenericFactory<Sealed>::freeze();
+  }();
+  for (auto _ : state) {
+    Sealed* obj = GenericFactory<Sealed>::create("Generated_50000");
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+  state.SetLabel(std::to_string(memory.before / 1024) + " KiB before, "
+                 + std::to_string(memory.after / 1024) + " KiB frozen");
+}
+BENCHMARK(BM_CreateFrozen);
+
+static void BM_CreateMissFrozen(benchmark::State& state) {  // NOLINT
+  growRegistry<Sealed>(100000);
+  GenericFactory<Sealed>::freeze();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(GenericFactory<Sealed>::create("NotRegistered"));
+}
+BENCHMARK(BM_CreateMissFrozen);
+
+// Looks up all 100k names in random order, so most lookups miss the cache.
+// Only the lookup is measured (classId() doesnt create anything).
+template<typename Base>
+static void BM_LookupAllNames(benchmark::State& state) {  // NOLINT
+  growRegistry<Base>(100000);
+  if (std::is_same<Base, Sealed>::value)
+    GenericFactory<Base>::freeze();
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < 100000; ++i)
+    names.push_back("Generated_" + std::to_string(i * 7919 % 100000));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GenericFactory<Base>::classId(names[i]));
+    i = i + 1 < names.size() ? i + 1 : 0;
+  }
+}
+BENCHMARK_TEMPLATE(BM_LookupAllNames, Node);
+BENCHMARK_TEMPLATE(BM_LookupAllNames, Sealed);
+
+// Every iteration registers a new class (in its own registry, the sizes
+// above stay put). The iterations are fixed, so every size grows by 100.
+static void BM_RegisterClass(benchmark::State& state) {  // NOLINT
+  growRegistry<Scratch>(state.range(0));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(registerGenerated<Scratch>());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RegisterClass)->RangeMultiplier(10)->Range(10, 100000)
+    ->Iterations(100);
+
+// Names of Nest<Node, N> are 4 + 6 * N characters long.
+template<int N>
+static void BM_CreateByNameLength(benchmark::State& state) {  // NOLINT
+  const std::string name(Nest<Node, N>::type::name.view());
+  for (auto _ : state) {
+    Node* obj = GenericFactory<Node>::create(name);
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+  state.SetLabel(std::to_string(name.size()) + " chars");
+}
+BENCHMARK_TEMPLATE(BM_CreateByNameLength, 1);
+BENCHMARK_TEMPLATE(BM_CreateByNameLength, 4);
+BENCHMARK_TEMPLATE(BM_CreateByNameLength, 16);
+BENCHMARK_TEMPLATE(BM_CreateByNameLength, kMaxNesting);
+
+template<int N>
+static void BM_CreateByHashedNameLength(benchmark::State& state) {  // NOLINT
+  for (auto _ : state) {
+    Node* obj =
+        GenericFactory<Node>::create<Nest<Node, N>::type::name.hash()>();
+    benchmark::DoNotOptimize(obj);
+    delete obj;
+  }
+}
+BENCHMARK_TEMPLATE(BM_CreateByHashedNameLength, 1);
+BENCHMARK_TEMPLATE(BM_CreateByHashedNameLength, kMaxNesting);
+
+// The names of Nest<Node, N> as literal_str_list, a chain of N + 1
+// literals. Converting and hashing it walks the chain.
+template<int N>
+struct LiteralNest {
+  static constexpr literal_str_list name =
+      LiteralNest<N - 1>::name + "_Layer";
+};
+template<>
+struct LiteralNest<0> {
+  static constexpr literal_str_list name = "Node";
+};
+
+template<int N>
+static void BM_LiteralToString(benchmark::State& state) {  // NOLINT
+  const literal_str_list* name = &LiteralNest<N>::name;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(name);
+    benchmark::DoNotOptimize(convert_to_string(*name));
+  }
+}
+BENCHMARK_TEMPLATE(BM_LiteralToString, 1);
+BENCHMARK_TEMPLATE(BM_LiteralToString, kMaxNesting);
+
+// A FixedString is flat, view() is free. This copies it.
+template<int N>
+static void BM_FixedToString(benchmark::State& state) {  // NOLINT
+  const auto* name = &Nest<Node, N>::type::name;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(name);
+    benchmark::DoNotOptimize(std::string(name->view()));
+  }
+}
+BENCHMARK_TEMPLATE(BM_FixedToString, 1);
+BENCHMARK_TEMPLATE(BM_FixedToString, kMaxNesting);
+
+// Hashing and concatenating are meant for compile time. These are the
+// costs if it happens at runtime.
+template<int N>
+static void BM_LiteralHash(benchmark::State& state) {  // NOLINT
+  const literal_str_list* name = &LiteralNest<N>::name;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(name);
+    benchmark::DoNotOptimize(name->hash());
+  }
+}
+BENCHMARK_TEMPLATE(BM_LiteralHash, 1);
+BENCHMARK_TEMPLATE(BM_LiteralHash, kMaxNesting);
+
+template<int N>
+static void BM_FixedHash(benchmark::State& state) {  // NOLINT
+  const auto* name = &Nest<Node, N>::type::name;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(name);
+    benchmark::DoNotOptimize(genericfactory::hashName(name->view()));
+  }
+}
+BENCHMARK_TEMPLATE(BM_FixedHash, 1);
+BENCHMARK_TEMPLATE(BM_FixedHash, kMaxNesting);
+
+static void BM_LiteralConcat(benchmark::State& state) {  // NOLINT
+  const literal_str_list* name = &LiteralNest<0>::name;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(name);
+    const literal_str_list once = *name + "_Layer";
+    const literal_str_list twice = once + "_Layer";
+    benchmark::DoNotOptimize(twice.size());
+  }
+}
+BENCHMARK(BM_LiteralConcat);
+
+// Registers StartupPlugin<Base, I>, lazily or not.
+template<typename Base, bool kLazy, int I>
+void registerStartup() {
+  if constexpr (kLazy)
+    GenericFactory<Base>::template registerClassLazy<StartupPlugin<Base, I> >();
+  else
+    GenericFactory<Base>::template registerClass<StartupPlugin<Base, I> >();
+}
+// One function per class, a call each keeps the compiler from inlining
+// thousands of registrations into one function.
+template<typename Base, bool kLazy, int... I>
+constexpr std::array<void (*)(), sizeof...(I)> startupRegistrations(
+      std::integer_sequence<int, I...>) {
+  return {{&registerStartup<Base, kLazy, I>...}};
+}
+
+// Startup of a tool with kCount plugin classes (8 properties each) that uses
+// two of them: register all, create two and set a property on them. Eager
+// registration runs every registerProperties(), lazy only the used ones.
+// Runs once, registering the classes again wouldnt be a startup.
+template<bool kLazy, int kCount>
+static void BM_Startup(benchmark::State& state) {  // NOLINT
+  typedef Startup<kLazy, kCount> Base;
+  for (auto _ : state) {
+    static constexpr auto registrations = startupRegistrations<Base, kLazy>(
+          std::make_integer_sequence<int, kCount>());
+    for (void (*registration)() : registrations)
+      registration();
+    for (int used : {0, kCount - 1}) {
+      Base* obj = GenericFactory<Base>::create(
+            "Plugin_" + std::to_string(used));
+      GenericFactory<Base>::template setProperty<int>("p0", obj, 1);
+      delete obj;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+// Every class is compiled, more would mostly slow down the build.
+BENCHMARK_TEMPLATE(BM_Startup, false, 10)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_Startup, true, 10)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_Startup, false, 100)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_Startup, true, 100)->Iterations(1);
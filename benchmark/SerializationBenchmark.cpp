@@ -0,0 +1,140 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <GenericFactory/GenericFactory_impl.h>
+#include <GenericFactory/Scene.h>
+#include <GenericFactory/Serialization.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "./BenchmarkClasses.h"
+
+using genericfactory::BinaryReader;
+using genericfactory::BinaryWriter;
+using genericfactory::GenericFactory;
+using genericfactory::SceneLoader;
+using genericfactory::SceneWriter;
+using genericfactory::TextReader;
+using genericfactory::TextWriter;
+
+namespace {
+std::vector<Plugin*> createShaders(std::size_t count) {
+  std::vector<Plugin*> objs;
+  for (std::size_t i = 0; i < count; ++i) {
+    Plugin* obj = GenericFactory<Plugin>::create("Shader_Cached");
+    GenericFactory<Plugin>::setProperty<int>("passes", obj, i % 8);
+    GenericFactory<Plugin>::setProperty<std::string>(
+          "source", obj, "void main() { }");
+    objs.push_back(obj);
+  }
+  return objs;
+}
+}  // namespace
+
+static void BM_SerializeBinary(benchmark::State& state) {  // NOLINT
+  const std::vector<Plugin*> objs = createShaders(state.range(0));
+  BinaryWriter writer;
+  for (auto _ : state) {
+    writer.clear();
+    for (const Plugin* obj : objs)
+      GenericFactory<Plugin>::serialize(obj, &writer);
+    benchmark::DoNotOptimize(writer.buffer().data());
+  }
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  for (Plugin* obj : objs)
+    delete obj;
+}
+BENCHMARK(BM_SerializeBinary)->Arg(10000);
+
+static void BM_DeserializeBinary(benchmark::State& state) {  // NOLINT
+  const std::vector<Plugin*> objs = createShaders(state.range(0));
+  BinaryWriter writer;
+  for (const Plugin* obj : objs)
+    GenericFactory<Plugin>::serialize(obj, &writer);
+  for (auto _ : state) {
+    BinaryReader reader(writer.buffer());
+    while (!reader.atEnd())
+      delete GenericFactory<Plugin>::deserialize(&reader);
+  }
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  for (Plugin* obj : objs)
+    delete obj;
+}
+BENCHMARK(BM_DeserializeBinary)->Arg(10000);
+
+static void BM_SerializeText(benchmark::State& state) {  // NOLINT
+  const std::vector<Plugin*> objs = createShaders(state.range(0));
+  TextWriter writer;
+  for (auto _ : state) {
+    writer.clear();
+    for (const Plugin* obj : objs)
+      GenericFactory<Plugin>::serialize(obj, &writer);
+    benchmark::DoNotOptimize(writer.text().data());
+  }
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  for (Plugin* obj : objs)
+    delete obj;
+}
+BENCHMARK(BM_SerializeText)->Arg(10000);
+
+static void BM_DeserializeText(benchmark::State& state) {  // NOLINT
+  const std::vector<Plugin*> objs = createShaders(state.range(0));
+  TextWriter writer;
+  for (const Plugin* obj : objs)
+    GenericFactory<Plugin>::serialize(obj, &writer);
+  for (auto _ : state) {
+    TextReader reader(writer.text());
+    while (!reader.atEnd())
+      delete GenericFactory<Plugin>::deserialize(&reader);
+  }
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  for (Plugin* obj : objs)
+    delete obj;
+}
+BENCHMARK(BM_DeserializeText)->Arg(10000);
+
+static void BM_LoadScene(benchmark::State& state) {  // NOLINT
+  const std::vector<Plugin*> objs = createShaders(state.range(0));
+  SceneWriter<Plugin> writer;
+  for (const Plugin* obj : objs)
+    writer.add(obj);
+  const char* const path = "benchmark_scene.bin";
+  writer.save(path);
+  std::vector<Plugin*> loaded;
+  loaded.reserve(objs.size());
+  for (auto _ : state) {
+    SceneLoader<Plugin> loader;
+    loader.open(path);
+    loader.load(&loaded);
+    for (Plugin* obj : loaded)
+      delete obj;
+    loaded.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * objs.size());
+  remove(path);
+  for (Plugin* obj : objs)
+    delete obj;
+}
+BENCHMARK(BM_LoadScene)->Arg(10000);
@@ -0,0 +1,94 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+#include <GenericFactory/Property.h>
+
+#include <string>
+
+using genericfactory::StringCastHelper;
+
+// The built in StringCastHelper against what the README used to suggest.
+static void BM_DoubleToString(benchmark::State& state) {  // NOLINT
+  double value = 0.1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    benchmark::DoNotOptimize(StringCastHelper<double>::toString(value));
+  }
+}
+BENCHMARK(BM_DoubleToString);
+
+static void BM_DoubleStdToString(benchmark::State& state) {  // NOLINT
+  double value = 0.1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    benchmark::DoNotOptimize(std::to_string(value));
+  }
+}
+BENCHMARK(BM_DoubleStdToString);
+
+static void BM_DoubleFromString(benchmark::State& state) {  // NOLINT
+  const std::string text("3.14159265358979");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringCastHelper<double>::fromString(text));
+}
+BENCHMARK(BM_DoubleFromString);
+
+static void BM_DoubleStod(benchmark::State& state) {  // NOLINT
+  const std::string text("3.14159265358979");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(std::stod(text));
+}
+BENCHMARK(BM_DoubleStod);
+
+static void BM_IntToString(benchmark::State& state) {  // NOLINT
+  int value = 123456;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    benchmark::DoNotOptimize(StringCastHelper<int>::toString(value));
+  }
+}
+BENCHMARK(BM_IntToString);
+
+static void BM_IntStdToString(benchmark::State& state) {  // NOLINT
+  int value = 123456;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    benchmark::DoNotOptimize(std::to_string(value));
+  }
+}
+BENCHMARK(BM_IntStdToString);
+
+static void BM_IntFromString(benchmark::State& state) {  // NOLINT
+  const std::string text("123456");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringCastHelper<int>::fromString(text));
+}
+BENCHMARK(BM_IntFromString);
+
+static void BM_IntStoi(benchmark::State& state) {  // NOLINT
+  const std::string text("123456");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(std::stoi(text));
+}
+BENCHMARK(BM_IntStoi);
@@ -0,0 +1,194 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef GENERICFACTORY_ALLOCATION_H_
+#define GENERICFACTORY_ALLOCATION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace genericfactory {
+/// Memory to create objects in with GenericFactory<Base>::create(name, &arena).
+/// Allocating just bumps a pointer. Objects live until reset() which calls
+/// their destructors (in reverse order) and reuses the memory.
+/// Not thread safe, use one arena per thread.
+class MonotonicArena {
+ public:
+  /// Called on reset() with the object to destroy.
+  typedef void (*Destructor)(void* object);
+
+  explicit MonotonicArena(std::size_t chunkSize = 64 * 1024)
+    : m_ChunkSize(chunkSize) { }
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+  ~MonotonicArena() {
+    reset();
+    for (Chunk& chunk : m_Chunks)
+      ::operator delete(chunk.memory, std::align_val_t(chunk.alignment));
+  }
+
+  /// Returns size bytes aligned to alignment (a power of two).
+  void* allocate(std::size_t size, std::size_t alignment) {
+    while (m_Current < m_Chunks.size()) {
+      Chunk& chunk = m_Chunks[m_Current];
+      const std::uintptr_t address =
+          reinterpret_cast<std::uintptr_t>(chunk.memory) + chunk.used;
+      const std::size_t begin =
+          chunk.used + ((alignment - address % alignment) % alignment);
+      if (begin + size <= chunk.size) {
+        chunk.used = begin + size;
+        return static_cast<char*>(chunk.memory) + begin;
+      }
+      ++m_Current;
+    }
+    // Doesnt fit anywhere, add a chunk big enough.
+    const std::size_t chunkAlignment =
+        alignment > alignof(std::max_align_t) ?
+        alignment : alignof(std::max_align_t);
+    const std::size_t chunkSize = size > m_ChunkSize ? size : m_ChunkSize;
+    m_Chunks.push_back(Chunk{
+        ::operator new(chunkSize, std::align_val_t(chunkAlignment)),
+        chunkSize, chunkAlignment, size});
+    m_Current = m_Chunks.size() - 1;
+    return m_Chunks.back().memory;
+  }
+  /// Calls destroy(object) on reset().
+  void onReset(Destructor destroy, void* object) {
+    Cleanup* cleanup = static_cast<Cleanup*>(
+          allocate(sizeof(Cleanup), alignof(Cleanup)));
+    cleanup->next = m_Cleanups;
+    cleanup->destroy = destroy;
+    cleanup->object = object;
+    m_Cleanups = cleanup;
+  }
+  /// Destroys all objects created in the arena. The memory is kept.
+  void reset() {
+    while (m_Cleanups) {
+      Cleanup* cleanup = m_Cleanups;
+      m_Cleanups = cleanup->next;
+      cleanup->destroy(cleanup->object);
+    }
+    for (Chunk& chunk : m_Chunks)
+      chunk.used = 0;
+    m_Current = 0;
+  }
+
+ private:
+  struct Chunk {
+    void* memory;
+    std::size_t size;
+    std::size_t alignment;
+    std::size_t used;
+  };
+  struct Cleanup {
+    Cleanup* next;
+    Destructor destroy;
+    void* object;
+  };
+  std::size_t m_ChunkSize;
+  std::vector<Chunk> m_Chunks;
+  /// Chunks before this one are full.
+  std::size_t m_Current = 0;
+  Cleanup* m_Cleanups = nullptr;
+};
+
+/// Memory to create objects in with GenericFactory<Base>::create(name, &pool).
+/// Blocks are kept in free lists by size, so objects of the same class reuse
+/// each others memory. Give objects back with
+/// GenericFactory<Base>::release(obj, &pool), dont delete them.
+/// Not thread safe, use one pool per thread.
+class ObjectPool {
+ public:
+  explicit ObjectPool(std::size_t blocksPerChunk = 64)
+    : m_BlocksPerChunk(blocksPerChunk) { }
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+  ~ObjectPool() {
+    for (const std::pair<void*, std::size_t>& chunk : m_Chunks)
+      ::operator delete(chunk.first, std::align_val_t(chunk.second));
+  }
+
+  /// Returns size bytes aligned to alignment (a power of two).
+  void* allocate(std::size_t size, std::size_t alignment) {
+    alignment = normalize(alignment);
+    const std::size_t stride = strideOf(size, alignment);
+    Block*& freeList = freeListOf(stride, alignment);
+    if (!freeList)
+      addChunk(&freeList, stride, alignment);
+    Block* block = freeList;
+    freeList = block->next;
+    return block;
+  }
+  /// Gives back memory returned by allocate with the same size and alignment.
+  void deallocate(void* memory, std::size_t size, std::size_t alignment) {
+    alignment = normalize(alignment);
+    Block*& freeList = freeListOf(strideOf(size, alignment), alignment);
+    Block* block = static_cast<Block*>(memory);
+    block->next = freeList;
+    freeList = block;
+  }
+
+ private:
+  struct Block {
+    Block* next;
+  };
+  static std::size_t normalize(std::size_t alignment) {
+    return alignment > alignof(std::max_align_t) ?
+        alignment : alignof(std::max_align_t);
+  }
+  static std::size_t strideOf(std::size_t size, std::size_t alignment) {
+    if (size < sizeof(Block))
+      size = sizeof(Block);
+    return (size + alignment - 1) & ~(alignment - 1);
+  }
+  /// The usual alignment goes by index, over aligned ones through a map.
+  Block*& freeListOf(std::size_t stride, std::size_t alignment) {
+    if (alignment == alignof(std::max_align_t)) {
+      const std::size_t index = stride / alignof(std::max_align_t);
+      if (index >= m_FreeLists.size())
+        m_FreeLists.resize(index + 1, nullptr);
+      return m_FreeLists[index];
+    }
+    return m_OverAligned[std::make_pair(stride, alignment)];
+  }
+  void addChunk(Block** freeList, std::size_t stride, std::size_t alignment) {
+    char* memory = static_cast<char*>(::operator new(
+          stride * m_BlocksPerChunk, std::align_val_t(alignment)));
+    m_Chunks.emplace_back(memory, alignment);
+    for (std::size_t i = m_BlocksPerChunk; i > 0; --i) {
+      Block* block = reinterpret_cast<Block*>(memory + (i - 1) * stride);
+      block->next = *freeList;
+      *freeList = block;
+    }
+  }
+  std::size_t m_BlocksPerChunk;
+  std::vector<Block*> m_FreeLists;
+  std::map<std::pair<std::size_t, std::size_t>, Block*> m_OverAligned;
+  /// Memory and alignment of every chunk.
+  std::vector<std::pair<void*, std::size_t> > m_Chunks;
+};
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_ALLOCATION_H_
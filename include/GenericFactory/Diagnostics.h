@@ -0,0 +1,138 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#ifndef GENERICFACTORY_DIAGNOSTICS_H_
+#define GENERICFACTORY_DIAGNOSTICS_H_
+
+#include <atomic>
+#include <cstdio>
+#include <string_view>  // NOLINT(build/include_order)
+
+namespace genericfactory {
+/// What went wrong. Returned by the try* functions of GenericFactory and
+/// passed to the DiagnosticSink.
+enum class ErrorCode {
+  kNone,
+  /// No class is registered under the name.
+  kUnknownClass,
+  /// The class of the object has no property with the name.
+  kUnknownProperty,
+  /// The property exists but has another type than the one asked for.
+  kWrongType,
+  /// The property was called on a object that doesnt own it.
+  kWrongObject,
+  /// The value wasnt parsed by the property it was set with.
+  kNotParsed,
+  /// The string isnt a valid value of the type of the property.
+  kBadValue,
+  /// A class or property was registered twice (the last one is used).
+  kDuplicateClass,
+  kDuplicateProperty,
+  /// The name of the class has the same hash as a registered one. The class
+  /// isnt registered.
+  kHashCollision,
+  /// The class has no static name field and isnt registered.
+  kMissingName,
+  /// The class is registered but cant be constructed (abstract or not
+  /// default constructible), reported when creating it.
+  kNotConstructible,
+  /// The object to release wasnt created by the factory.
+  kNotRegistered,
+  /// The file cant be read or has the wrong format.
+  kBadFile,
+  /// Registering after GenericFactory<Base>::freeze().
+  kFrozen,
+  /// Cloning a object whose class isnt copy constructible.
+  kNotCopyable
+};
+
+/// Returns a short description of code.
+inline const char* describe(ErrorCode code) {
+  switch (code) {
+    case ErrorCode::kNone:
+      return "no error";
+    case ErrorCode::kUnknownClass:
+      return "there is no class named";
+    case ErrorCode::kUnknownProperty:
+      return "there is no property named";
+    case ErrorCode::kWrongType:
+      return "the property has another type";
+    case ErrorCode::kWrongObject:
+      return "cant call this property on this object";
+    case ErrorCode::kNotParsed:
+      return "the value wasnt parsed by this property";
+    case ErrorCode::kBadValue:
+      return "cant convert the value";
+    case ErrorCode::kDuplicateClass:
+      return "there already exists a class named";
+    case ErrorCode::kDuplicateProperty:
+      return "there already exists a property named";
+    case ErrorCode::kHashCollision:
+      return "the name has the same hash as a registered one";
+    case ErrorCode::kMissingName:
+      return "the class is missing the static name field";
+    case ErrorCode::kNotConstructible:
+      return "the class is abstract or not default constructible";
+    case ErrorCode::kNotRegistered:
+      return "the class isnt registered";
+    case ErrorCode::kBadFile:
+      return "cant read the file";
+    case ErrorCode::kFrozen:
+      return "the registry is frozen";
+    case ErrorCode::kNotCopyable:
+      return "the class isnt copy constructible";
+  }
+  return "unknown error";
+}
+
+/// Gets every error the factory doesnt return to the caller, together with
+/// the name (of the class or property) it is about. It may be called from
+/// any thread.
+typedef void (*DiagnosticSink)(ErrorCode code, std::string_view subject);
+
+/// A sink that writes the errors to stderr (what the factory used to do).
+inline void stderrSink(ErrorCode code, std::string_view subject) {
+  fprintf(stderr, "%s %.*s\n", describe(code),
+      static_cast<int>(subject.size()), subject.data());
+}
+
+/// The installed sink, nullptr (nothing is reported) by default.
+inline std::atomic<DiagnosticSink>& diagnosticSink() {
+  static std::atomic<DiagnosticSink> m_Sink{nullptr};
+  return m_Sink;
+}
+
+/// Installs sink (nullptr to report nothing) and returns the one installed
+/// before.
+inline DiagnosticSink setDiagnosticSink(DiagnosticSink sink) {
+  return diagnosticSink().exchange(sink);
+}
+
+/// Passes the error to the installed sink, if there is one.
+inline void report(ErrorCode code, std::string_view subject) {
+  const DiagnosticSink sink = diagnosticSink().load(std::memory_order_acquire);
+  if (sink)
+    sink(code, subject);
+}
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_DIAGNOSTICS_H_
@@ -0,0 +1,89 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#ifndef GENERICFACTORY_FIXEDSTRING_H_
+#define GENERICFACTORY_FIXEDSTRING_H_
+
+#include <cstddef>
+#include <string_view>  // NOLINT(build/include_order)
+
+#include "GenericFactory/HashedName.h"
+
+namespace genericfactory {
+/// A name of N characters stored flat in a array. Concatenations are done
+/// while compiling, so T::name + "_ofD" is one array in the binary and
+/// size(), hash() and view() are constants:
+///   static constexpr FixedString name = "A";
+///   static constexpr auto name = T::name + "_ofD";
+template<std::size_t N>
+class FixedString {
+ public:
+  constexpr FixedString(const char (&text)[N + 1])  // NOLINT(runtime/explicit)
+      : m_Chars{} {
+    for (std::size_t i = 0; i < N; ++i)
+      m_Chars[i] = text[i];
+  }
+  template<std::size_t M>
+  constexpr FixedString<N + M - 1> operator+(const char (&text)[M]) const {
+    return FixedString<N + M - 1>(view(), std::string_view(text, M - 1));
+  }
+  template<std::size_t M>
+  constexpr FixedString<N + M> operator+(const FixedString<M>& text) const {
+    return FixedString<N + M>(view(), text.view());
+  }
+  constexpr std::size_t size() const {
+    return N;
+  }
+  constexpr char operator[](std::size_t i) const {
+    return m_Chars[i];
+  }
+  constexpr std::string_view view() const {
+    return std::string_view(m_Chars, N);
+  }
+  constexpr operator std::string_view() const {  // NOLINT(runtime/explicit)
+    return view();
+  }
+  constexpr const char* c_str() const {
+    return m_Chars;
+  }
+  /// Same as hashName(view()).
+  constexpr std::size_t hash() const {
+    return hashName(view());
+  }
+
+ private:
+  template<std::size_t> friend class FixedString;
+  /// Concatenates head and tail (N characters together).
+  constexpr FixedString(std::string_view head, std::string_view tail)
+      : m_Chars{} {
+    for (std::size_t i = 0; i < head.size(); ++i)
+      m_Chars[i] = head[i];
+    for (std::size_t i = 0; i < tail.size(); ++i)
+      m_Chars[head.size() + i] = tail[i];
+  }
+  char m_Chars[N + 1];
+};
+template<std::size_t N>
+FixedString(const char (&)[N]) -> FixedString<N - 1>;
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_FIXEDSTRING_H_
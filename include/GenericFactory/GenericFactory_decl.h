@@ -25,14 +25,36 @@
 
 #include <cstdio>
 #include <string>
-#include <map>
+#include <string_view>  // NOLINT(build/include_order)
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include "GenericFactory/GenericFactory_fwd.h"
+#include "GenericFactory/HashedName.h"
 
 class literal_str_list;
 
 namespace genericfactory {
+template<std::size_t N> class FixedString;
 template<typename T> class Property;
+template<typename T> class PropertyHandle;
+template<typename T> struct NonDeduced;
+template<typename Base> struct ClassInfo;
+template<typename Base> class HelperClassMap;
+class MonotonicArena;
+class ObjectPool;
+class BinaryWriter;
+class BinaryReader;
+class TextWriter;
+class TextReader;
+struct FactoryStats;
+enum class ErrorCode;
+template<typename Base> class HelperPropertyMap;
+/// Heap bytes of the registries of a base before and after freeze().
+struct RegistryMemory {
+  std::size_t before;
+  std::size_t after;
+};
 struct BasicCase { };
 struct SpecialCase : BasicCase { };
 template<typename> struct OkCase { typedef int type; };
@@ -48,19 +70,179 @@ class GenericFactory {
   /// Registeres all classes for base (has to be user defined).
   static char registerAllForBase();
   /// Use this method to create a object of class name.
-  static Base* create(const std::string& name);
+  /// Accepts std::string, const char* and std::string_view without building
+  /// a temporary std::string.
+  static Base* create(std::string_view name);
+  /// Creates the object in arena instead of on the heap. It is destroyed by
+  /// arena->reset(), dont delete it.
+  static Base* create(std::string_view name, MonotonicArena* const arena);
+  /// Creates the object in a block of pool instead of on the heap. Give it
+  /// back with release(), dont delete it.
+  static Base* create(std::string_view name, ObjectPool* const pool);
+  /// Destroys a object created in pool and gives its memory back.
+  static void release(Base* const objPtr, ObjectPool* const pool);
+  /// Creates count objects of class name in one block, back to back, and
+  /// writes them to objPtrs. The class is looked up once. Returns count or
+  /// 0 if there is no such class. Destroy them all at once with
+  /// destroyMany(objPtrs, count), dont delete them.
+  /// Throws std::bad_array_new_length if count objects dont fit in memory.
+  /// If a constructor throws the objects constructed so far are destroyed
+  /// and the exception is rethrown.
+  static std::size_t createMany(
+        std::string_view name,
+        std::size_t count,
+        Base** const objPtrs);
+  /// Same as above in arena, destroyed by arena->reset().
+  static std::size_t createMany(
+        std::string_view name,
+        std::size_t count,
+        Base** const objPtrs,
+        MonotonicArena* const arena);
+  /// Destroys objects created by createMany (on the heap) and frees their
+  /// block. objPtrs and count have to be the ones given to createMany.
+  static void destroyMany(Base* const* const objPtrs, std::size_t count);
+  /// Creates a object of the class whose name hashes to Hash, e.g.
+  /// create<D<B>::name.hash()>(). Neither hashes nor compares at runtime.
+  template<std::size_t Hash>
+  static Base* create();
+  /// Same as above with a hash computed beforehand.
+  static Base* create(HashedName name);
+
+  /// Interned names: classId()/propertyId() look a name up once, the
+  /// overloads taking the id index arrays instead of hashing and comparing
+  /// the name. Ids stay valid while the programm runs, unknown names give a
+  /// id that converts to false.
+  static ClassId classId(std::string_view name);
+  static PropertyId propertyId(std::string_view propName);
+  static Base* create(ClassId id);
+
+  /// Returns a copy (copy constructed) of objPtr, nullptr if its class isnt
+  /// registered or copy constructible.
+  static Base* clone(const Base* const objPtr);
+  /// Registers prototype, a object of a registered class with its
+  /// properties set, as presetName and takes ownership of it. The creates
+  /// give copies of it, no property is set again. Objects of presets are
+  /// objects of their class (properties, serialize(), clone()).
+  static void registerPreset(
+        const std::string& presetName,
+        Base* const prototype);
+
+  /// Same as create(name) but returns why nothing was created instead of
+  /// reporting it to the DiagnosticSink (see Diagnostics.h). *objPtr is the
+  /// new object or nullptr.
+  static ErrorCode tryCreate(std::string_view name, Base** const objPtr);
 
   /// Calls the method with given name on the object to set a property value.
+  /// Only properties of the class of the object and its bases are found.
+  /// Errors go to the DiagnosticSink (see Diagnostics.h).
   static void setProperty(
-        const std::string& propName,
+        std::string_view propName,
         Base* const objPtr,
         const std::string& value);
 
   /// Calls the method with given name on the object to get a property value.
   static std::string getProperty(
-        const std::string& propName,
+        std::string_view propName,
+        Base* const objPtr);
+
+  /// Sets the same values (pairs of property name and value) on count
+  /// objects. The objects are grouped by class, every property is looked up
+  /// and its value converted only once per class. Values that cant be
+  /// converted are reported (kBadValue) and set on none of the objects.
+  /// Returns the number of properties set.
+  static std::size_t setProperties(
+        Base* const* const objPtrs,
+        std::size_t count,
+        const std::vector<std::pair<std::string, std::string> >& values);
+
+  /// Typed versions of setProperty/getProperty, e.g.
+  /// setProperty<float>("name", obj, 1.0f). No strings are involved. T has to
+  /// be the exact type of the property. setProperty returns false if it
+  /// isnt, getProperty returns T().
+  template<typename T>
+  static bool setProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const typename NonDeduced<T>::type& value);
+  template<typename T>
+  static T getProperty(
+        std::string_view propName,
         Base* const objPtr);
 
+  /// setProperty/getProperty by interned name (see propertyId()).
+  static void setProperty(
+        PropertyId propId,
+        Base* const objPtr,
+        const std::string& value);
+  static std::string getProperty(PropertyId propId, Base* const objPtr);
+  template<typename T>
+  static bool setProperty(
+        PropertyId propId,
+        Base* const objPtr,
+        const typename NonDeduced<T>::type& value);
+  template<typename T>
+  static T getProperty(PropertyId propId, Base* const objPtr);
+
+  /// Same as setProperty/getProperty but return why nothing was set or got
+  /// instead of reporting it. A miss costs a branch, nothing is printed.
+  /// tryGetProperty writes the value to *value only on success.
+  static ErrorCode trySetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const std::string& value);
+  static ErrorCode tryGetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        std::string* const value);
+  template<typename T>
+  static ErrorCode trySetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const typename NonDeduced<T>::type& value);
+  template<typename T>
+  static ErrorCode tryGetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        T* const value);
+
+  /// Looks up the property once for the dynamic type of objPtr. Use the
+  /// handle to get/set it on objects of the same type without any lookup.
+  /// Returns a empty handle if there is no such property.
+  static PropertyHandle<Base> findProperty(
+        std::string_view propName,
+        const Base* const objPtr);
+  /// Same as findProperty but returns kUnknownProperty for unknown names.
+  static ErrorCode tryFindProperty(
+        std::string_view propName,
+        const Base* const objPtr,
+        PropertyHandle<Base>* const handle);
+
+  /// Appends the class name and all properties of the object to writer
+  /// (see Serialization.h). Returns false if its class isnt registered.
+  static bool serialize(const Base* const objPtr, BinaryWriter* const writer);
+  /// Creates the next object of reader and sets its properties. Unknown
+  /// properties are skipped. Returns nullptr if the class is unknown or the
+  /// data is cut off.
+  static Base* deserialize(BinaryReader* const reader);
+  /// Same in the text form (values go through StringCastHelper).
+  static bool serialize(const Base* const objPtr, TextWriter* const writer);
+  static Base* deserialize(TextReader* const reader);
+
+  /// Returns the counters and latencies collected so far. They are only
+  /// collected if ENABLEINSTRUMENTATION is defined, otherwise the stats are
+  /// empty and nothing is counted.
+  static FactoryStats stats();
+
+  /// Call once all classes and properties are registered and no other
+  /// thread uses the factory. Runs the pending registerProperties() of lazy
+  /// classes, packs the classes into one flat index (lookups touch one slot
+  /// and the name) and frees what registering left behind. Registrations
+  /// after this are reported as kFrozen and ignored.
+  /// Only the classes are packed. The property tables stay hash tables, one
+  /// per dynamic type, resolved on its first use as before; freeze() just
+  /// frees the ones left behind.
+  static RegistryMemory freeze();
+
   /// Registers the class in GenericFactory<Base> of type C
   /// There will be errors if C is not of type Base,
   /// If C is not DefaultConstructable,
@@ -70,27 +252,43 @@ class GenericFactory {
       && std::is_constructible<C>::value, int>::type = 0>
   static void registerClass();
   /// Registers just the properties but doesnt add the class to the
-  /// constructables.
+  /// constructables. Creating it by its name reports kNotConstructible.
   template<typename C, typename std::enable_if<
       std::is_abstract<C>::value
       || !std::is_constructible<C>::value, int>::type = 0>
   static void registerClass();
+  /// Same as registerClass but only stores the name and how to construct C.
+  /// registerProperties() of C runs on the first use of the properties of
+  /// a object deriving from C (from any thread, once). Cheaper if only a few
+  /// of many classes are used. Abstract C are registered right away.
+  template<typename C>
+  static void registerClassLazy();
   /// Registers a method of C to be called by the name methodName.
   /// Use callMethod(...) to call the method on a object.
-  template<typename C, typename Type>
+  /// The setter may take the value by value, const T& or T&&, the getter may
+  /// return it by value or const T&. Both have to use the same T.
+  template<typename C, typename SetArg, typename GetResult>
   static void registerProperty(
         const std::string& methodName,
-        void (C::*setPtr)(Type),
-        Type (C::*getPtr)() const);
+        void (C::*setPtr)(SetArg),
+        GetResult (C::*getPtr)() const);
+  /// Registers the data member memberPtr of C by the name memberName, e.g.
+  /// registerProperty("size", &C::size). Gets and sets load and store the
+  /// member, PropertyHandle::copy() copies trivially copyable ones with
+  /// memcpy.
+  template<typename C, typename Type>
+  static void registerProperty(
+        const std::string& memberName,
+        Type C::*memberPtr);
 
  private:
   /// We dont want anyone to create this.
   GenericFactory();
   /// This is the map that holds all the registered classes.
-  static std::map<std::string, Base*>& reflectionMap();
+  static HelperClassMap<Base>& reflectionMap();
 
   /// This is the map that holds all registered properties.
-  static std::map<std::string, Property<Base>*>& properyMap();
+  static HelperPropertyMap<Base>& properyMap();
 
   // TODO(Mi 27. Aug 14:28:59 CEST 2014, bauschp): Think of a way to move this
   // currently needed for cv++.
@@ -100,29 +298,36 @@ class GenericFactory {
   static void helpRegisterProperties(SpecialCase s) {
     // call register Properties.
     C::registerProperties();
-    printf("%zu after calling %s::registerProperties().\n", properyMap().size(),
-      nameOf(C::name).c_str());
   }
 
+  // registerProperties() is optional.
   template<typename C>
-  static void helpRegisterProperties(BasicCase b) {
-    fprintf(stderr, "Couldn't find static void C::registerProperties()\n");
-  }
+  static void helpRegisterProperties(BasicCase b) { }
 
-  template<
-        typename C,
-        typename OkCase<decltype(C::name)>::type = 0,
-        typename OkCase<decltype(&C::create)>::type = 0>
+  template<typename C, typename OkCase<decltype(C::name)>::type = 0>
   static void helpRegisterClass(SpecialCase s);
   // Dont register if u cant find the name.
   template<typename C>
   static void helpRegisterClass(BasicCase b);
+  // Remembers the name of a class that cant be created.
+  template<typename C, typename OkCase<decltype(C::name)>::type = 0>
+  static void helpRegisterNotCreatable(SpecialCase s);
+  template<typename C>
+  static void helpRegisterNotCreatable(BasicCase b) { }
 
   // Helper to get the name in a uniform way.
   static std::string nameOf(const char* const name);
   static std::string nameOf(const std::string& name);
+  // Helper to get the hash of the name (see hashName()).
+  static std::size_t hashOf(const char* const name);
+  static std::size_t hashOf(const std::string& name);
+  template<std::size_t N>
+  static std::string nameOf(const FixedString<N>& name);
+  template<std::size_t N>
+  static std::size_t hashOf(const FixedString<N>& name);
 #ifndef DISABLELITERALSTRING
   static std::string nameOf(const literal_str_list& name);
+  static std::size_t hashOf(const literal_str_list& name);
 #endif  // DISABLELITERALSTRING
 };
 }  // namespace genericfactory
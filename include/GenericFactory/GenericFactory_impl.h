@@ -23,57 +23,846 @@
 #ifndef GENERICFACTORY_GENERICFACTORY_IMPL_H_
 #define GENERICFACTORY_GENERICFACTORY_IMPL_H_
 
+#include <typeindex>
 #include <typeinfo>
 
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "GenericFactory/Allocation.h"
+#include "GenericFactory/Diagnostics.h"
+#include "GenericFactory/FixedString.h"
 #include "GenericFactory/GenericFactory_decl.h"
+#include "GenericFactory/HashedName.h"
+#include "GenericFactory/Instrumentation.h"
 #include "GenericFactory/Property.h"
 #ifndef DISABLELITERALSTRING
 #include "./LiteralStringList.h"
 #endif  // DISABLELITERALSTRING
 namespace genericfactory {
 // HELPER START
-/// There two are helper functions to check wheter or not the base has a create
-/// method. This is important, cause all stored pointers are of this type and
-/// create has to exist in order to create objects of subclasses.
-template<typename Base, typename OkCase<decltype(&Base::create)>::type = 0>
-Base* creationHelper(
-      const std::string& name,
-      std::map<std::string, Base*> reflectionMap,
-      SpecialCase) {
-  Base* creator = reflectionMap[name];
-  if (!creator)
+/// Creates a object of the registered class (nullptr if there is none).
+template<typename Base>
+Base* creationHelper(const ClassInfo<Base>* info) {
+  if (!info) {
+    Instrumentation<Base>::countClassMiss();
     return nullptr;
-  return creator->create();
+  }
+  typename Instrumentation<Base>::Sample sample(Operation::kCreate);
+  Instrumentation<Base>::countCreate(info);
+  if (info->prototype)
+    return info->clone(info->prototype.get());
+  return info->create();
 }
-/// See above. this is the case if Base doesnt have create().
+
+/// Constructs a object of info in memory, a copy of the prototype for
+/// presets.
 template<typename Base>
-Base* creationHelper(
-      const std::string&,
-      std::map<std::string, Base*>,
-      BasicCase) {
-  printf("WHY :(.\n");
-  return nullptr;
+Base* helpConstruct(const ClassInfo<Base>* info, void* const memory) {
+  if (info->prototype)
+    return info->copy(memory, info->prototype.get());
+  return info->construct(memory);
+}
+
+template<typename To, typename From, typename = void>
+struct HelperStaticCastable : std::false_type { };
+template<typename To, typename From>
+struct HelperStaticCastable<To, From, std::void_t<
+    decltype(static_cast<To>(std::declval<From>()))> > : std::true_type { };
+
+/// Casts obj to C, its dynamic type. Only virtual bases need a dynamic_cast.
+template<typename C, typename Base>
+const C& helperDowncast(const Base* const obj) {
+  if constexpr (HelperStaticCastable<const C*, const Base*>::value)
+    return *static_cast<const C*>(obj);
+  else
+    return *dynamic_cast<const C*>(obj);
 }
 
-/// This helper class is used to delete the pointers of the static
-/// map when the programm terminates. (Composite)
-template<typename Key, typename Value>
-class HelperPointerMap {
+/// The names are hashed with FNV-1a already, no need to hash them again.
+struct HelperIdentityHash {
+  std::size_t operator()(std::size_t hash) const {
+    return hash;
+  }
+};
+
+/// Key of a type for HelperAtomicMap. Scrambles the address of type (mixing
+/// is bijective, keys stay unique).
+inline std::size_t helperTypeKey(const std::type_info& type) {
+  std::uint64_t key = reinterpret_cast<std::uintptr_t>(&type);
+  key *= 0x9E3779B97F4A7C15u;
+  return static_cast<std::size_t>(key ^ (key >> 32));
+}
+
+/// Key of the class whose properties this thread registers lazily (see
+/// HelperClassMap::readyFor()), 0 if none. No resolved type derives from
+/// it yet, its properties dont invalidate any.
+inline std::size_t& helperReadying() {
+  static thread_local std::size_t key = 0;
+  return key;
+}
+
+/// Hash table keyed by precomputed hashes. Any number of threads can find()
+/// without taking a lock, insert() and clear() have to be serialized by the
+/// caller. Nothing is freed before the map is destroyed (not replaced values,
+/// not the tables left behind when growing or clearing), so whatever a
+/// reader found stays valid. Memory stays linear as tables grow by doubling.
+template<typename Value>
+class HelperAtomicMap {
+ public:
+  HelperAtomicMap() {
+    clear();
+  }
+  /// Returns the value stored under key or nullptr. Lock free.
+  const Value* find(std::size_t key) const {
+    const Table* table = m_Table.load(std::memory_order_acquire);
+    for (std::size_t i = key & table->mask;; i = (i + 1) & table->mask) {
+      const Node* node = table->slots[i].load(std::memory_order_acquire);
+      if (!node)
+        return nullptr;
+      if (node->key == key)
+        return &node->value;
+    }
+  }
+  /// Stores value under key, replacing what was stored before.
+  void insert(std::size_t key, Value value) {
+    m_Nodes.emplace_back(new Node{key, std::move(value)});
+    const Node* node = m_Nodes.back().get();
+    Table* table = m_Tables.back().get();
+    std::atomic<const Node*>* slot = slotOf(table, key);
+    if (slot->load(std::memory_order_relaxed)) {
+      slot->store(node, std::memory_order_release);
+      return;
+    }
+    // Keep the load factor below 3/4.
+    if ((table->count.load() + 1) * 4 > (table->mask + 1) * 3) {
+      table = grow(table);
+      slot = slotOf(table, key);
+    }
+    slot->store(node, std::memory_order_release);
+    ++table->count;
+  }
+  /// Starts over with a empty table.
+  void clear() {
+    m_Tables.emplace_back(newTable(16));
+    m_Table.store(m_Tables.back().get(), std::memory_order_release);
+  }
+  /// Publishes a table without the values remove(value) is true for, if
+  /// there are any. Like clear(), readers may still use them.
+  template<typename Predicate>
+  void removeIf(Predicate remove) {
+    const Table* table = m_Tables.back().get();
+    std::size_t removed = 0;
+    for (std::size_t i = 0; i <= table->mask; ++i) {
+      const Node* node = table->slots[i].load(std::memory_order_relaxed);
+      removed += node && remove(node->value);
+    }
+    if (!removed)
+      return;
+    Table* kept = newTable(table->mask + 1);
+    for (std::size_t i = 0; i <= table->mask; ++i) {
+      const Node* node = table->slots[i].load(std::memory_order_relaxed);
+      if (node && !remove(node->value)) {
+        slotOf(kept, node->key)->store(node, std::memory_order_relaxed);
+        ++kept->count;
+      }
+    }
+    m_Tables.emplace_back(kept);
+    m_Table.store(kept, std::memory_order_release);
+  }
+  std::size_t size() const {
+    return m_Table.load(std::memory_order_acquire)->count;
+  }
+  /// Heap bytes of the tables and nodes (not of what the values own).
+  std::size_t bytes() const {
+    std::size_t bytes = m_Nodes.size() * sizeof(Node);
+    for (const std::unique_ptr<Table>& table : m_Tables)
+      bytes += sizeof(Table) + (table->mask + 1) * sizeof(table->slots[0]);
+    return bytes;
+  }
+  /// Same as above plus valueBytes(value) for every value, found or not.
+  template<typename ValueBytes>
+  std::size_t bytes(ValueBytes valueBytes) const {
+    std::size_t bytes = this->bytes();
+    for (const std::unique_ptr<Node>& node : m_Nodes)
+      bytes += valueBytes(node->value);
+    return bytes;
+  }
+  /// Frees the tables left behind by growing and clearing and, if
+  /// freeValues, the values no longer found (replaced or cleared). Nothing
+  /// else may use the map meanwhile.
+  void compact(bool freeValues) {
+    const Table* current = m_Table.load(std::memory_order_relaxed);
+    m_Tables.erase(std::remove_if(m_Tables.begin(), m_Tables.end(),
+          [current](const std::unique_ptr<Table>& table) {
+            return table.get() != current;
+          }),
+        m_Tables.end());
+    if (!freeValues)
+      return;
+    std::unordered_set<const Node*> found;
+    for (std::size_t i = 0; i <= current->mask; ++i)
+      found.insert(current->slots[i].load(std::memory_order_relaxed));
+    m_Nodes.erase(std::remove_if(m_Nodes.begin(), m_Nodes.end(),
+          [&found](const std::unique_ptr<Node>& node) {
+            return !found.count(node.get());
+          }),
+        m_Nodes.end());
+  }
+
+ private:
+  struct Node {
+    std::size_t key;
+    Value value;
+  };
+  struct Table {
+    std::size_t mask;
+    std::atomic<std::size_t> count;
+    std::unique_ptr<std::atomic<const Node*>[]> slots;
+  };
+  static Table* newTable(std::size_t capacity) {
+    return new Table{capacity - 1, {0},
+        std::unique_ptr<std::atomic<const Node*>[]>(
+            new std::atomic<const Node*>[capacity]())};
+  }
+  /// Slot holding key or the empty slot key would go into.
+  static std::atomic<const Node*>* slotOf(Table* table, std::size_t key) {
+    std::size_t i = key & table->mask;
+    while (true) {
+      const Node* node = table->slots[i].load(std::memory_order_relaxed);
+      if (!node || node->key == key)
+        return &table->slots[i];
+      i = (i + 1) & table->mask;
+    }
+  }
+  /// Publishes a table twice the size of table with the same nodes.
+  Table* grow(const Table* table) {
+    Table* bigger = newTable((table->mask + 1) * 2);
+    for (std::size_t i = 0; i <= table->mask; ++i) {
+      const Node* node = table->slots[i].load(std::memory_order_relaxed);
+      if (node) {
+        slotOf(bigger, node->key)->store(node, std::memory_order_relaxed);
+        ++bigger->count;
+      }
+    }
+    m_Tables.emplace_back(bigger);
+    m_Table.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+  std::atomic<const Table*> m_Table;
+  std::vector<std::unique_ptr<Table> > m_Tables;
+  std::vector<std::unique_ptr<Node> > m_Nodes;
+};
+
+/// What the factory knows about a registered class.
+template<typename Base>
+struct ClassInfo {
+  std::string name;
+  const std::type_info* type;
+  std::size_t size;
+  std::size_t alignment;
+  /// Default constructs the class on the heap.
+  Base* (*create)();
+  /// Default constructs the class in memory (size bytes aligned to
+  /// alignment) and returns it.
+  Base* (*construct)(void* memory);
+  /// Copy constructs the class from obj (of exactly this class) on the heap
+  /// / in memory. nullptr if the class isnt copy constructible.
+  Base* (*clone)(const Base* obj);
+  Base* (*copy)(void* memory, const Base* obj);
+  /// Interned name (see ClassId), set by HelperClassMap::insert().
+  std::uint32_t id;
+  /// The object copied by presets (see registerPreset()), nullptr for
+  /// classes.
+  std::unique_ptr<const Base> prototype;
+};
+
+/// This helper class is used to delete the registered classes when the
+/// programm terminates. (Composite)
+/// It is keyed by the FNV-1a hash of the name (see hashName()) with O(1)
+/// expected lookup. Names are kept to detect hash collisions, lookups by name
+/// never allocate. Classes can be found by their type too.
+/// Lookups dont lock (see HelperAtomicMap).
+template<typename Base>
+class HelperClassMap {
  public:
-  ~HelperPointerMap() {
-    auto it = m_Map.begin();
-    auto endIt = m_Map.end();
-    for (; it != endIt; ++it) {
-      delete it->second;
+  /// A class in the frozen index, followed by its name. Enough to create a
+  /// object without touching its ClassInfo (create is nullptr for presets).
+  struct Slot {
+    std::size_t hash;
+    Base* (*create)();
+    const ClassInfo<Base>* info;
+    std::uint32_t id;
+    std::uint32_t nameSize;
+    std::string_view name() const {
+      return std::string_view(reinterpret_cast<const char*>(this + 1),
+                              nameSize);
+    }
+  };
+  /// Returns the class registered as name or nullptr.
+  const ClassInfo<Base>* find(std::string_view name) const {
+    if (const Frozen* frozen = m_Frozen.load(std::memory_order_acquire)) {
+      const Slot* slot = frozen->find(hashName(name), name);
+      return slot ? slot->info : nullptr;
+    }
+    const ClassInfo<Base>* info = find(hashName(name));
+    if (!info || info->name != name)
+      return nullptr;
+    return info;
+  }
+  /// Returns the class registered with the precomputed hash or nullptr.
+  const ClassInfo<Base>* find(std::size_t hash) const {
+    if (const Frozen* frozen = m_Frozen.load(std::memory_order_acquire)) {
+      const Slot* slot = frozen->find(hash);
+      return slot ? slot->info : nullptr;
+    }
+    const std::unique_ptr<ClassInfo<Base> >* info = m_Names.find(hash);
+    return info ? info->get() : nullptr;
+  }
+  /// Returns the slot of name in the frozen index, nullptr if there is no
+  /// such class or the map isnt frozen.
+  const Slot* findFrozen(std::string_view name) const {
+    const Frozen* frozen = m_Frozen.load(std::memory_order_acquire);
+    return frozen ? frozen->find(hashName(name), name) : nullptr;
+  }
+  bool frozen() const {
+    return m_Frozen.load(std::memory_order_acquire) != nullptr;
+  }
+  /// Builds the frozen index: the slots with their names back to back in
+  /// one block and a index of 8 bytes per entry (linear probing, at most
+  /// half full) holding the upper half of the hash and where the slot is.
+  /// A lookup reads a index entry and one slot. Frees the tables left behind
+  /// while registering, lookups by name dont use m_Names any more. Nothing
+  /// else may use the map meanwhile.
+  void freeze() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Frozen.load(std::memory_order_relaxed))
+      return;
+    std::unique_ptr<Frozen> frozen(new Frozen());
+    std::size_t words = 0;
+    for (const std::unique_ptr<ClassInfo<Base> >* info : m_Infos)
+      words += Frozen::wordsOf((*info)->name.size());
+    frozen->slots.reserve(words);
+    std::size_t capacity = 16;
+    while (capacity < m_Names.size() * 2)
+      capacity *= 2;
+    frozen->mask = capacity - 1;
+    frozen->index.resize(capacity);
+    for (const std::unique_ptr<ClassInfo<Base> >* info : m_Infos) {
+      const std::size_t hash = hashName((*info)->name);
+      // Replaced classes arent found by their name any more.
+      if (find(hash) != info->get())
+        continue;
+      std::size_t i = hash & frozen->mask;
+      while (frozen->index[i])
+        i = (i + 1) & frozen->mask;
+      const std::size_t position = frozen->slots.size();
+      frozen->index[i] = Frozen::entryOf(hash, position);
+      frozen->slots.resize(position + Frozen::wordsOf((*info)->name.size()));
+      Slot* slot = new (&frozen->slots[position])
+          Slot{hash, (*info)->prototype ? nullptr : (*info)->create,
+               info->get(), (*info)->id,
+               static_cast<std::uint32_t>((*info)->name.size())};
+      std::memcpy(slot + 1, (*info)->name.data(), slot->nameSize);
+      ++frozen->count;
+    }
+    frozen->slots.shrink_to_fit();
+    m_Names.clear();
+    m_Names.compact(false);
+    m_Types.compact(true);
+    m_Ids.compact(true);
+    m_Infos.clear();
+    m_Infos.shrink_to_fit();
+    m_FrozenOwner.reset(frozen.release());
+    m_Frozen.store(m_FrozenOwner.get(), std::memory_order_release);
+  }
+  /// Heap bytes of the map, roughly.
+  std::size_t bytes() const {
+    std::size_t bytes = m_Names.bytes() + m_Types.bytes() + m_Ids.bytes()
+        + m_Infos.capacity() * sizeof(m_Infos[0]);
+    if (const Frozen* frozen = m_Frozen.load(std::memory_order_acquire)) {
+      bytes += sizeof(Frozen) + frozen->index.capacity() * sizeof(Entry)
+          + frozen->slots.capacity() * sizeof(Entry);
+    }
+    return bytes;
+  }
+  /// Returns the class with the interned name id or nullptr. Ids are dense,
+  /// the probe hits the slot id.
+  const ClassInfo<Base>* find(ClassId id) const {
+    const ClassInfo<Base>* const* info = m_Ids.find(id.value);
+    return info ? *info : nullptr;
+  }
+  /// Returns the class of the dynamic type of obj or nullptr.
+  const ClassInfo<Base>* find(const Base* const obj) const {
+    const ClassInfo<Base>* const* info =
+        m_Types.find(helperTypeKey(typeid(*obj)));
+    return info ? *info : nullptr;
+  }
+  /// Registers the class under hash (has to be hashName(info->name)) unless
+  /// another name has the same hash. A new name gets the next id, a replaced
+  /// class keeps it. Returns the name registered with hash before this call
+  /// or nullptr.
+  const std::string* insert(std::size_t hash, ClassInfo<Base>* info) {
+    std::unique_ptr<ClassInfo<Base> > newInfo(info);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const ClassInfo<Base>* old = find(hash);
+    if (!old || old->name == info->name) {
+      info->id = old ? old->id : m_NextId++;
+      // Objects of presets are found as objects of their class.
+      if (!info->prototype)
+        m_Types.insert(helperTypeKey(*info->type), info);
+      m_Ids.insert(info->id, info);
+      m_Names.insert(hash, std::move(newInfo));
+      m_Infos.push_back(m_Names.find(hash));
+    }
+    return old ? &old->name : nullptr;
+  }
+  /// Remembers that the class registered as name (with hash) cant be
+  /// created, so missing() can tell it apart from a unknown name.
+  void insertNotCreatable(std::size_t hash, std::string name) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_NotCreatable.emplace(hash, std::move(name));
+  }
+  /// Returns why there is no class to create as name: kNotConstructible if
+  /// it was registered but cant be created, else kUnknownClass.
+  ErrorCode missing(std::string_view name) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const auto it = m_NotCreatable.find(hashName(name));
+    return it != m_NotCreatable.end() && it->second == name
+        ? ErrorCode::kNotConstructible : ErrorCode::kUnknownClass;
+  }
+  /// Remembers to call registerProperties() once a object deriving from the
+  /// class (key of its type, isBaseOf(obj)) needs its properties (see
+  /// readyFor()). A class registered again under another name is remembered
+  /// once.
+  void insertLazy(
+        std::size_t type,
+        void (*registerProperties)(),
+        bool (*isBaseOf)(const Base* const obj)) {
+    std::lock_guard<std::recursive_mutex> lock(m_LazyMutex);
+    if (!m_LazyTypes.emplace(type, m_Lazy.size()).second)
+      return;
+    m_Lazy.push_back(Lazy{type, registerProperties, isBaseOf});
+    m_LazyCount.fetch_add(1, std::memory_order_release);
+  }
+  /// Registers the properties of every lazily registered class obj derives
+  /// from. Costs a load once all of them are registered.
+  /// The class of obj is found by its type. Bases need a cast, every class is
+  /// tested once per dynamic type.
+  void readyFor(const Base* const obj) {
+    if (!m_LazyCount.load(std::memory_order_acquire))
+      return;
+    // Recursive: registerProperties() may create objects.
+    std::lock_guard<std::recursive_mutex> lock(m_LazyMutex);
+    const std::size_t key = helperTypeKey(typeid(*obj));
+    const auto self = m_LazyTypes.find(key);
+    if (self != m_LazyTypes.end())
+      ready(self->second);
+    // Stays valid while registerProperties() adds to the map.
+    std::size_t& tested = m_LazyTested[key];
+    for (; tested < m_Lazy.size(); ++tested) {
+      if (m_Lazy[tested].registerProperties && m_Lazy[tested].isBaseOf(obj))
+        ready(tested);
     }
   }
-  std::map<Key, Value*>& map() {
-    return m_Map;
+  /// Registers the properties of all lazily registered classes.
+  void readyAll() {
+    if (!m_LazyCount.load(std::memory_order_acquire))
+      return;
+    std::lock_guard<std::recursive_mutex> lock(m_LazyMutex);
+    for (std::size_t i = 0; i < m_Lazy.size(); ++i) {
+      if (m_Lazy[i].registerProperties)
+        ready(i);
+    }
   }
+  std::size_t size() const {
+    const Frozen* frozen = m_Frozen.load(std::memory_order_acquire);
+    return frozen ? frozen->count : m_Names.size();
+  }
+
  private:
-  std::map<Key, Value*> m_Map;
+  struct Lazy {
+    std::size_t type;
+    /// nullptr once called.
+    void (*registerProperties)();
+    bool (*isBaseOf)(const Base* const obj);
+  };
+  /// Index entries and the words of the slots. A entry is the upper half
+  /// of the hash and the position of the slot + 1 (0 is empty).
+  typedef std::uint64_t Entry;
+  struct Frozen {
+    static std::size_t wordsOf(std::size_t nameSize) {
+      return (sizeof(Slot) + nameSize + sizeof(Entry) - 1) / sizeof(Entry);
+    }
+    static Entry entryOf(std::size_t hash, std::size_t position) {
+      return (static_cast<Entry>(hash) & ~Entry(0xFFFFFFFFu)) | (position + 1);
+    }
+    const Slot* find(std::size_t hash) const {
+      const Entry tag = static_cast<Entry>(hash) & ~Entry(0xFFFFFFFFu);
+      for (std::size_t i = hash & mask; index[i]; i = (i + 1) & mask) {
+        if ((index[i] & ~Entry(0xFFFFFFFFu)) != tag)
+          continue;
+        const Slot* slot = reinterpret_cast<const Slot*>(
+            &slots[(index[i] & 0xFFFFFFFFu) - 1]);
+        if (slot->hash == hash)
+          return slot;
+      }
+      return nullptr;
+    }
+    const Slot* find(std::size_t hash, std::string_view name) const {
+      const Slot* slot = find(hash);
+      return slot && slot->name() == name ? slot : nullptr;
+    }
+    std::size_t mask;
+    std::size_t count = 0;
+    std::vector<Entry> index;
+    std::vector<Entry> slots;
+  };
+  /// Calls registerProperties() of m_Lazy[i], m_LazyMutex is locked.
+  void ready(std::size_t i) {
+    void (*registerProperties)() = m_Lazy[i].registerProperties;
+    const std::size_t type = m_Lazy[i].type;
+    m_Lazy[i].registerProperties = nullptr;
+    m_LazyTypes.erase(type);
+    const std::size_t readying = helperReadying();
+    helperReadying() = type;
+    registerProperties();
+    helperReadying() = readying;
+    m_LazyCount.fetch_sub(1, std::memory_order_release);
+  }
+
+  HelperAtomicMap<std::unique_ptr<ClassInfo<Base> > > m_Names;
+  HelperAtomicMap<const ClassInfo<Base>*> m_Types;
+  HelperAtomicMap<const ClassInfo<Base>*> m_Ids;
+  /// Every class in the order it was registered, until freeze().
+  std::vector<const std::unique_ptr<ClassInfo<Base> >*> m_Infos;
+  std::atomic<const Frozen*> m_Frozen{nullptr};
+  /// Owns what m_Frozen points to.
+  std::unique_ptr<const Frozen> m_FrozenOwner;
+  std::uint32_t m_NextId = 0;
+  /// Names of the abstract (or not default constructible) classes by hash.
+  std::unordered_map<std::size_t, std::string> m_NotCreatable;
+  /// Serializes insert().
+  std::mutex m_Mutex;
+  /// Lazily registered classes in the order they were registered.
+  std::vector<Lazy> m_Lazy;
+  /// Index in m_Lazy by type, for the ones whose properties arent registered.
+  std::unordered_map<std::size_t, std::size_t> m_LazyTypes;
+  /// Number of m_Lazy entries tested against each dynamic type.
+  std::unordered_map<std::size_t, std::size_t> m_LazyTested;
+  /// Number of classes whose properties arent registered.
+  std::atomic<std::size_t> m_LazyCount{0};
+  std::recursive_mutex m_LazyMutex;
+};
+
+/// Holds the properties of every class that registered some, and deletes
+/// them when the programm terminates.
+/// For every dynamic type a property is used on a table of all properties of
+/// the type and its bases is resolved once. Lookups go through typeid and
+/// dont cast, so two classes can use the same property name. Only the first
+/// lookup for a type locks (see HelperAtomicMap).
+/// Registering a property resolves the types using its class again, all
+/// types if the class had no properties before. Readers may still use the
+/// old tables, they are kept until compact(): registering while objects are
+/// in use costs a table per such type.
+template<typename Base>
+class HelperPropertyMap {
+ public:
+  /// A property resolved for one dynamic type.
+  struct Bound {
+    std::size_t hash;
+    std::string_view name;
+    PropertyHandle<Base> handle;
+  };
+  /// prepare(obj) is called before the properties of a dynamic type are
+  /// resolved, it may register properties.
+  explicit HelperPropertyMap(void (*prepare)(const Base* const obj))
+      : m_Prepare(prepare) { }
+  /// Adds the property to the table of the class owning it.
+  /// Returns false if it replaced one with the same name. The replaced one is
+  /// kept until the programm terminates, handles to it stay valid.
+  bool insert(std::string_view name, Property<Base>* property) {
+    std::unique_ptr<Property<Base> > prop(property);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const std::type_index owner(property->ownerType());
+    auto ownerIt = m_Owners.begin();
+    while (ownerIt != m_Owners.end() && ownerIt->owner != owner)
+      ++ownerIt;
+    // Dynamic types have to be resolved again, unless the owner is registered
+    // lazily right now. Types deriving from a known owner use its table.
+    if (m_Types.size()
+        && helperTypeKey(property->ownerType()) != helperReadying()) {
+      if (ownerIt == m_Owners.end()) {
+        m_Types.clear();
+      } else {
+        const OwnerTable* const changed = &*ownerIt;
+        m_Types.removeIf([changed](const Table& table) {
+          return std::find(table.owners.begin(), table.owners.end(), changed)
+              != table.owners.end();
+        });
+      }
+    }
+    if (ownerIt == m_Owners.end())
+      ownerIt = m_Owners.insert(m_Owners.end(), OwnerTable{owner, {}});
+    const std::size_t hash = hashName(name);
+    Entry& entry = ownerIt->properties[hash];
+    const bool replaced = entry.property != nullptr;
+    if (replaced) {
+      m_Replaced.push_back(
+            Entry{entry.name, std::move(entry.property)});
+    } else {
+      ++m_Size;
+    }
+    entry.name = name;
+    entry.property = std::move(prop);
+    intern(name, hash);
+    return !replaced;
+  }
+  /// Returns the id of the property name (see PropertyId). Lock free.
+  PropertyId idOf(std::string_view name) const {
+    const Symbol* symbol = m_Symbols.find(hashName(name));
+    if (!symbol || symbol->name != name)
+      return PropertyId();
+    return PropertyId(symbol->id);
+  }
+  /// Returns the property called name of the dynamic type of obj or nullptr.
+  /// Doesnt add anything for unknown names.
+  const PropertyHandle<Base>* find(
+        const Base* const obj,
+        std::string_view name) {
+    const Bound* bound = tableOf(obj)->find(hashName(name));
+    if (!bound || bound->name != name)
+      return nullptr;
+    return &bound->handle;
+  }
+  /// Same as above by interned name, indexes a array.
+  const PropertyHandle<Base>* find(const Base* const obj, PropertyId id) {
+    const Table* table = tableOf(obj);
+    if (id.value >= table->byId.size() || !table->byId[id.value])
+      return nullptr;
+    return &table->byId[id.value];
+  }
+  /// Calls visit(name, handle) for every property of the dynamic type of
+  /// obj. Returns the number of properties.
+  template<typename Visitor>
+  std::size_t forEach(const Base* const obj, Visitor visit) {
+    const Table* table = tableOf(obj);
+    for (const Bound& bound : table->slots) {
+      if (bound.handle)
+        visit(bound.name, bound.handle);
+    }
+    return table->count;
+  }
+  /// Resolves the dynamic types again on their next use.
+  void invalidate() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Generation.fetch_add(1, std::memory_order_release);
+    if (m_Types.size())
+      m_Types.clear();
+  }
+  /// Frees the resolved tables left behind while registering. Nothing else
+  /// may use the map meanwhile.
+  void compact() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Types.compact(true);
+    m_Symbols.compact(false);
+  }
+  /// Heap bytes of the map, roughly.
+  std::size_t bytes() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::size_t bytes = m_Types.bytes([](const Table& table) {
+          return table.slots.capacity() * sizeof(Bound)
+              + table.byId.capacity() * sizeof(PropertyHandle<Base>)
+              + table.owners.capacity() * sizeof(const OwnerTable*);
+        }) + m_Symbols.bytes() + m_Replaced.capacity() * sizeof(Entry)
+        + m_SymbolNames.capacity() * sizeof(std::string);
+    for (const OwnerTable& owner : m_Owners) {
+      bytes += sizeof(OwnerTable) + owner.properties.bucket_count()
+          * sizeof(void*) + owner.properties.size()
+          * (sizeof(Entry) + 2 * sizeof(void*));
+    }
+    return bytes;
+  }
+  std::size_t size() const {
+    return m_Size;
+  }
+  /// Returns the name property was registered with. Only for reports, this
+  /// searches all properties.
+  std::string nameOf(const void* const property) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const OwnerTable& owner : m_Owners) {
+      for (const auto& entry : owner.properties) {
+        if (entry.second.property.get() == property)
+          return entry.second.name;
+      }
+    }
+    for (const Entry& entry : m_Replaced) {
+      if (entry.property.get() == property)
+        return entry.name;
+    }
+    return std::string();
+  }
+  /// Returns the name id was interned for (see idOf), empty for unknown ids.
+  std::string nameOf(PropertyId id) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return id.value < m_SymbolNames.size() ? m_SymbolNames[id.value]
+                                           : std::string();
+  }
+
+ private:
+  struct OwnerTable;
+  /// The properties of one dynamic type in one array (linear probing, at
+  /// most half full). Never changes once resolved.
+  struct Table {
+    const Bound* find(std::size_t hash) const {
+      for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        if (!slots[i].handle || slots[i].hash == hash)
+          return slots[i].handle ? &slots[i] : nullptr;
+      }
+    }
+    /// Adds bound or replaces the one with the same hash.
+    void insert(const Bound& bound) {
+      std::size_t i = bound.hash & mask;
+      while (slots[i].handle && slots[i].hash != bound.hash)
+        i = (i + 1) & mask;
+      count += !slots[i].handle;
+      slots[i] = bound;
+    }
+    std::size_t mask;
+    std::size_t count;
+    std::vector<Bound> slots;
+    /// Indexed by property id, empty handles for properties of other types.
+    std::vector<PropertyHandle<Base> > byId;
+    /// The classes the type derives from that have properties.
+    std::vector<const OwnerTable*> owners;
+  };
+  struct Entry {
+    std::string name;
+    std::unique_ptr<Property<Base> > property;
+  };
+  struct Symbol {
+    std::string name;
+    std::uint32_t id;
+  };
+  struct OwnerTable {
+    std::type_index owner;
+    std::unordered_map<std::size_t, Entry, HelperIdentityHash> properties;
+  };
+  /// Returns the resolved table of the dynamic type of obj.
+  /// prepare() runs without the lock. A class registered lazily meanwhile
+  /// changes m_Generation, then it runs again instead of caching a table
+  /// without the properties of that class.
+  const Table* tableOf(const Base* const obj) {
+    const std::size_t key = helperTypeKey(typeid(*obj));
+    const Table* table = m_Types.find(key);
+    while (!table) {
+      const std::size_t generation =
+          m_Generation.load(std::memory_order_acquire);
+      m_Prepare(obj);
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      table = m_Types.find(key);
+      if (!table
+          && generation == m_Generation.load(std::memory_order_relaxed)) {
+        m_Types.insert(key, resolve(obj));
+        table = m_Types.find(key);
+        // Resolved while registering lazily, it may derive from the class.
+        helperReadying() = 0;
+      }
+    }
+    return table;
+  }
+  /// Collects the properties of all classes obj derives from. If names
+  /// clash the most derived class wins, no matter which one registered
+  /// first. A class without data of its own has the size of its base, of
+  /// those two the one that registered first loses.
+  Table resolve(const Base* const obj) const {
+    struct Owner {
+      const OwnerTable* table;
+      std::ptrdiff_t offset;
+      std::ptrdiff_t size;
+      /// Number of the other owners this one derives from.
+      std::size_t depth;
+    };
+    std::vector<Owner> owners;
+    for (const OwnerTable& owner : m_Owners) {
+      std::ptrdiff_t offset;
+      if (owner.properties.empty())
+        continue;
+      const Property<Base>& property = *owner.properties.begin()->second
+          .property;
+      if (property.ownerOffset(obj, &offset)) {
+        owners.push_back(Owner{&owner, offset,
+              static_cast<std::ptrdiff_t>(property.ownerSize()), 0});
+      }
+    }
+    // The subobject of a base lies in the one of the class deriving from it
+    // and is smaller. Only a few classes of one hierarchy, pairwise is fine.
+    for (Owner& derived : owners) {
+      for (const Owner& base : owners) {
+        derived.depth += base.size < derived.size
+            && base.offset >= derived.offset
+            && base.offset + base.size <= derived.offset + derived.size;
+      }
+    }
+    std::stable_sort(owners.begin(), owners.end(),
+          [](const Owner& a, const Owner& b) { return a.depth < b.depth; });
+    std::vector<Bound> bounds;
+    std::vector<const OwnerTable*> tables;
+    for (const Owner& owner : owners) {
+      tables.push_back(owner.table);
+      const std::ptrdiff_t offset = owner.offset;
+      for (const auto& entry : owner.table->properties) {
+        bounds.push_back(Bound{entry.first, entry.second.name,
+              PropertyHandle<Base>(entry.second.property.get(), obj,
+                                   offset)});
+      }
+    }
+    std::size_t capacity = 4;
+    while (capacity < bounds.size() * 2)
+      capacity *= 2;
+    Table table{capacity - 1, 0, std::vector<Bound>(capacity),
+        std::vector<PropertyHandle<Base> >(m_SymbolCount), std::move(tables)};
+    for (const Bound& bound : bounds) {
+      table.insert(bound);
+      const Symbol* symbol = m_Symbols.find(bound.hash);
+      if (symbol && symbol->name == bound.name)
+        table.byId[symbol->id] = bound.handle;
+    }
+    return table;
+  }
+  /// Gives name the next id unless it (or a name with its hash) has one.
+  void intern(std::string_view name, std::size_t hash) {
+    if (!m_Symbols.find(hash)) {
+      m_Symbols.insert(hash, Symbol{std::string(name), m_SymbolCount++});
+      m_SymbolNames.emplace_back(name);
+    }
+  }
+  /// In the order the classes registered their first property.
+  std::deque<OwnerTable> m_Owners;
+  std::vector<Entry> m_Replaced;
+  HelperAtomicMap<Table> m_Types;
+  /// Property names by hash, with their ids.
+  HelperAtomicMap<Symbol> m_Symbols;
+  std::uint32_t m_SymbolCount = 0;
+  /// Property names by id, only for reports.
+  std::vector<std::string> m_SymbolNames;
+  std::atomic<std::size_t> m_Size{0};
+  void (*m_Prepare)(const Base* const obj);
+  /// Changed by invalidate(), see tableOf().
+  std::atomic<std::size_t> m_Generation{0};
+  /// Serializes changes and the first lookup of every type.
+  std::mutex m_Mutex;
 };
 
 // HELPER END
@@ -92,27 +881,60 @@ char GenericFactory<Base>::registerAllForBase() {
 
 // Definitions to access the static maps.
 template<typename Base>
-std::map<std::string, Base*>& GenericFactory<Base>::reflectionMap() {
-  static HelperPointerMap<std::string, Base> m_ReflMap;
-  return m_ReflMap.map();
+HelperClassMap<Base>& GenericFactory<Base>::reflectionMap() {
+  static HelperClassMap<Base> m_ReflMap;
+  return m_ReflMap;
 }
 
 template<typename Base>
-std::map<std::string, Property<Base>*>& GenericFactory<Base>::properyMap() {
-  static HelperPointerMap<std::string, Property<Base> > m_PropMap;
-  return m_PropMap.map();
+HelperPropertyMap<Base>& GenericFactory<Base>::properyMap() {
+  // Lazily registered classes register their properties here.
+  static HelperPropertyMap<Base> m_PropMap([](const Base* const obj) {
+    reflectionMap().readyFor(obj);
+  });
+  return m_PropMap;
 }
 template<typename Base>
-template<typename C, typename Type>
+template<typename C, typename SetArg, typename GetResult>
 void GenericFactory<Base>::registerProperty(
       const std::string& methodName,
-      void (C::*setPtr)(Type),
-      Type (C::*getPtr)() const) {
-  if (properyMap().find(methodName) != properyMap().end()) {
-    perror("There already exists a property with this name\n");
-    delete properyMap()[methodName];
+      void (C::*setPtr)(SetArg),
+      GetResult (C::*getPtr)() const) {
+  typedef typename std::decay<SetArg>::type Type;
+  static_assert(std::is_same<Type,
+        typename std::decay<GetResult>::type>::value,
+        "Setter and getter have to use the same type\n");
+  static_assert(!std::is_reference<GetResult>::value
+        || std::is_const<typename std::remove_reference<GetResult>::type>
+           ::value,
+        "Getters have to return by value or const reference\n");
+  static_assert(!std::is_lvalue_reference<SetArg>::value
+        || std::is_const<typename std::remove_reference<SetArg>::type>
+           ::value,
+        "Setters have to take the value by value, const T& or T&&\n");
+  if (reflectionMap().frozen()) {
+    report(ErrorCode::kFrozen, methodName);
+    return;
   }
-  properyMap()[methodName] = new TypeProperty<Base, C, Type>(setPtr, getPtr);
+  if (!properyMap().insert(methodName,
+        new TypeProperty<Base, C, Type, SetArg, GetResult>(setPtr, getPtr)))
+    report(ErrorCode::kDuplicateProperty, methodName);
+}
+
+template<typename Base>
+template<typename C, typename Type>
+void GenericFactory<Base>::registerProperty(
+      const std::string& memberName,
+      Type C::*memberPtr) {
+  static_assert(!std::is_function<Type>::value,
+        "Use registerProperty(name, setPtr, getPtr) for methods\n");
+  if (reflectionMap().frozen()) {
+    report(ErrorCode::kFrozen, memberName);
+    return;
+  }
+  if (!properyMap().insert(memberName,
+        new FieldProperty<Base, C, Type>(memberPtr)))
+    report(ErrorCode::kDuplicateProperty, memberName);
 }
 
 template<typename Base>
@@ -131,68 +953,682 @@ template<typename C, typename std::enable_if<
       std::is_abstract<C>::value
       || !std::is_constructible<C>::value, int>::type>
 void GenericFactory<Base>::registerClass() {
-  printf("Can't create this class. Adding Properties...\n");
+  helpRegisterNotCreatable<C>(SpecialCase());
   GenericFactory<Base>::helpRegisterProperties<C>(SpecialCase());
 }
 
 template<typename Base>
-template<
-      typename C,
-      typename OkCase<decltype(C::name)>::type,
-      typename OkCase<decltype(&C::create)>::type>
+template<typename C>
+void GenericFactory<Base>::registerClassLazy() {
+  static_assert(std::is_base_of<Base, C>::value,
+        "C dosn`t have base Base\n");
+  if constexpr (std::is_abstract<C>::value
+                || !std::is_constructible<C>::value) {
+    registerClass<C>();
+  } else if (reflectionMap().frozen()) {
+    report(ErrorCode::kFrozen, nameOf(C::name));
+  } else {
+    helpRegisterClass<C>(SpecialCase());
+    reflectionMap().insertLazy(helperTypeKey(typeid(C)),
+        []() { helpRegisterProperties<C>(SpecialCase()); },
+        [](const Base* const obj) {
+          return dynamic_cast<const C*>(obj) != nullptr;
+        });
+    // Types resolved before dont know the new properties yet.
+    properyMap().invalidate();
+  }
+}
+
+template<typename Base>
+template<typename C, typename OkCase<decltype(C::name)>::type>
 void GenericFactory<Base>::helpRegisterClass(SpecialCase) {
   std::string name = nameOf(C::name);
   // This is used to register them automaticly.
   if (sizeof(helpInit) != sizeof(helpInit) && helpInit)
     return;
-  printf("REGISTERING %s.\n", name.c_str());
-  if (reflectionMap().find(name) != reflectionMap().end()) {
-    perror("There already exists a class with this name\n");
-    delete reflectionMap()[name];
+  if (reflectionMap().frozen()) {
+    report(ErrorCode::kFrozen, name);
+    return;
   }
-  // only default constructable C will land here.
-  // just construct one.
-  reflectionMap()[name] = new C();
+  // only default constructable C will land here. Nothing is constructed
+  // now, only the thunks are stored. Collisions are checked here so create()
+  // can trust the hash.
+  Base* (*clone)(const Base* obj) = nullptr;
+  Base* (*copy)(void* memory, const Base* obj) = nullptr;
+  if constexpr (std::is_copy_constructible<C>::value) {
+    clone = [](const Base* obj) -> Base* {
+      return new C(helperDowncast<C>(obj));
+    };
+    copy = [](void* memory, const Base* obj) -> Base* {
+      return new (memory) C(helperDowncast<C>(obj));
+    };
+  }
+  ClassInfo<Base>* info = new ClassInfo<Base>{name, &typeid(C), sizeof(C),
+      alignof(C),
+      []() -> Base* { return new C(); },
+      [](void* memory) -> Base* { return new (memory) C(); },
+      clone, copy, ClassId::kUnknown, nullptr};
+  const std::string* taken = reflectionMap().insert(hashOf(C::name), info);
+  if (taken && *taken != name)
+    report(ErrorCode::kHashCollision, name);
+  else if (taken)
+    report(ErrorCode::kDuplicateClass, name);
 }
 
 template<typename Base>
 template<typename C>
 void GenericFactory<Base>::helpRegisterClass(BasicCase) {
-  fprintf(stderr, "(%s) is missing the static field with the reflection "
-      "name or Base* create() const member. Make sure you add them!!.\n",
-      typeid(C).name());
+  report(ErrorCode::kMissingName, typeid(C).name());
+}
+
+template<typename Base>
+template<typename C, typename OkCase<decltype(C::name)>::type>
+void GenericFactory<Base>::helpRegisterNotCreatable(SpecialCase) {
+  reflectionMap().insertNotCreatable(hashOf(C::name), nameOf(C::name));
 }
 
 // Definitions to access a property. (get/set).
 template<typename Base>
 void GenericFactory<Base>::setProperty(
-        const std::string& propName,
+        std::string_view propName,
         Base* const objPtr,
         const std::string& value) {
-  Property<Base>* prop = properyMap()[propName];
-  if (prop) {
-    prop->set(objPtr, value);
-    return;
-  }
-  fprintf(stderr, "There is no property named %s\n", propName.c_str());
+  const ErrorCode error = trySetProperty(propName, objPtr, value);
+  if (error != ErrorCode::kNone)
+    report(error, propName);
 }
 
 template<typename Base>
 std::string GenericFactory<Base>::getProperty(
-        const std::string& propName,
+        std::string_view propName,
         Base* const objPtr) {
-  Property<Base>* prop = properyMap()[propName];
-  if (prop)
-    return prop->get(objPtr);
-  fprintf(stderr, "There is no property named %s\n", propName.c_str());
+  std::string value;
+  const ErrorCode error = tryGetProperty(propName, objPtr, &value);
+  if (error == ErrorCode::kNone)
+    return value;
+  report(error, propName);
   return "ERROR";
 }
 
+template<typename Base>
+std::size_t GenericFactory<Base>::setProperties(
+        Base* const* const objPtrs,
+        std::size_t count,
+        const std::vector<std::pair<std::string, std::string> >& values) {
+  std::unordered_map<const std::type_info*, std::vector<Base*> > classes;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (objPtrs[i])
+      classes[&typeid(*objPtrs[i])].push_back(objPtrs[i]);
+  }
+  std::size_t setCount = 0;
+  for (const auto& objs : classes) {
+    for (const auto& value : values) {
+      const auto* prop = properyMap().find(objs.second.front(), value.first);
+      if (!prop) {
+        Instrumentation<Base>::countPropertyMiss();
+        report(ErrorCode::kUnknownProperty, value.first);
+        continue;
+      }
+      const std::any parsed = prop->parse(value.second);
+      if (!parsed.has_value()) {
+        report(ErrorCode::kBadValue, value.first);
+        continue;
+      }
+      for (Base* const obj : objs.second)
+        prop->setParsed(obj, parsed);
+      setCount += objs.second.size();
+    }
+  }
+  return setCount;
+}
+
+template<typename Base>
+template<typename T>
+bool GenericFactory<Base>::setProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const typename NonDeduced<T>::type& value) {
+  const ErrorCode error = trySetProperty<T>(propName, objPtr, value);
+  if (error == ErrorCode::kNone)
+    return true;
+  report(error, propName);
+  return false;
+}
+
+template<typename Base>
+template<typename T>
+T GenericFactory<Base>::getProperty(
+        std::string_view propName,
+        Base* const objPtr) {
+  T value = T();
+  const ErrorCode error = tryGetProperty<T>(propName, objPtr, &value);
+  if (error != ErrorCode::kNone)
+    report(error, propName);
+  return value;
+}
+
+template<typename Base>
+ErrorCode GenericFactory<Base>::trySetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const std::string& value) {
+  const auto* prop = properyMap().find(objPtr, propName);
+  if (!prop) {
+    Instrumentation<Base>::countPropertyMiss();
+    return ErrorCode::kUnknownProperty;
+  }
+  if (!prop->set(objPtr, value))
+    return ErrorCode::kBadValue;
+  return ErrorCode::kNone;
+}
+
+template<typename Base>
+ErrorCode GenericFactory<Base>::tryGetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        std::string* const value) {
+  const auto* prop = properyMap().find(objPtr, propName);
+  if (!prop) {
+    Instrumentation<Base>::countPropertyMiss();
+    return ErrorCode::kUnknownProperty;
+  }
+  *value = prop->get(objPtr);
+  return ErrorCode::kNone;
+}
+
+template<typename Base>
+template<typename T>
+ErrorCode GenericFactory<Base>::trySetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const typename NonDeduced<T>::type& value) {
+  const auto* prop = properyMap().find(objPtr, propName);
+  if (!prop) {
+    Instrumentation<Base>::countPropertyMiss();
+    return ErrorCode::kUnknownProperty;
+  }
+  if (!prop->template setValue<T>(objPtr, value)) {
+    Instrumentation<Base>::countPropertyMiss();
+    return ErrorCode::kWrongType;
+  }
+  return ErrorCode::kNone;
+}
+
+template<typename Base>
+template<typename T>
+ErrorCode GenericFactory<Base>::tryGetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        T* const value) {
+  const auto* prop = properyMap().find(objPtr, propName);
+  if (!prop) {
+    Instrumentation<Base>::countPropertyMiss();
+    return ErrorCode::kUnknownProperty;
+  }
+  if (!prop->template hasType<T>()) {
+    Instrumentation<Base>::countPropertyMiss();
+    return ErrorCode::kWrongType;
+  }
+  *value = prop->template getValue<T>(objPtr);
+  return ErrorCode::kNone;
+}
+
+template<typename Base>
+PropertyHandle<Base> GenericFactory<Base>::findProperty(
+        std::string_view propName,
+        const Base* const objPtr) {
+  PropertyHandle<Base> handle;
+  tryFindProperty(propName, objPtr, &handle);
+  return handle;
+}
+
+template<typename Base>
+ErrorCode GenericFactory<Base>::tryFindProperty(
+        std::string_view propName,
+        const Base* const objPtr,
+        PropertyHandle<Base>* const handle) {
+  const PropertyHandle<Base>* prop = properyMap().find(objPtr, propName);
+  if (!prop) {
+    Instrumentation<Base>::countPropertyMiss();
+    return ErrorCode::kUnknownProperty;
+  }
+  *handle = *prop;
+  return ErrorCode::kNone;
+}
+
+template<typename Base>
+bool GenericFactory<Base>::serialize(
+        const Base* const objPtr,
+        BinaryWriter* const writer) {
+  const ClassInfo<Base>* info = reflectionMap().find(objPtr);
+  if (!info) {
+    report(ErrorCode::kNotRegistered, typeid(*objPtr).name());
+    return false;
+  }
+  writer->writeString(info->name);
+  const std::size_t count = writer->beginBlock();
+  const std::size_t written = properyMap().forEach(objPtr,
+      [objPtr, writer](std::string_view name,
+                       const PropertyHandle<Base>& handle) {
+    writer->writeString(name);
+    const std::size_t value = writer->beginBlock();
+    handle.write(objPtr, writer);
+    writer->endBlock(value);
+  });
+  writer->patchSize(count, static_cast<std::uint32_t>(written));
+  return true;
+}
+
+template<typename Base>
+Base* GenericFactory<Base>::deserialize(BinaryReader* const reader) {
+  std::string_view name;
+  std::uint32_t count;
+  if (!reader->readString(&name) || !reader->readSize(&count)) {
+    report(ErrorCode::kBadValue, name);
+    return nullptr;
+  }
+  Base* obj = create(name);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    std::string_view propName;
+    std::string_view value;
+    if (!reader->readString(&propName) || !reader->readString(&value)) {
+      report(ErrorCode::kBadValue, name);
+      delete obj;
+      return nullptr;
+    }
+    // Keep reading to skip the object if the class is unknown.
+    if (!obj)
+      continue;
+    const PropertyHandle<Base>* prop = properyMap().find(obj, propName);
+    if (!prop)
+      report(ErrorCode::kUnknownProperty, propName);
+    else if (!prop->read(obj, value))
+      report(ErrorCode::kBadValue, propName);
+  }
+  return obj;
+}
+
+template<typename Base>
+bool GenericFactory<Base>::serialize(
+        const Base* const objPtr,
+        TextWriter* const writer) {
+  const ClassInfo<Base>* info = reflectionMap().find(objPtr);
+  if (!info) {
+    report(ErrorCode::kNotRegistered, typeid(*objPtr).name());
+    return false;
+  }
+  writer->writeClass(info->name);
+  properyMap().forEach(objPtr,
+      [objPtr, writer](std::string_view name,
+                       const PropertyHandle<Base>& handle) {
+    writer->writeProperty(name, handle.get(objPtr));
+  });
+  writer->endObject();
+  return true;
+}
+
+template<typename Base>
+Base* GenericFactory<Base>::deserialize(TextReader* const reader) {
+  std::string_view name;
+  if (!reader->readClass(&name))
+    return nullptr;
+  Base* obj = create(name);
+  std::string_view propName;
+  std::string value;
+  while (reader->readProperty(&propName, &value)) {
+    if (obj)
+      setProperty(propName, obj, value);
+  }
+  return obj;
+}
+
+template<typename Base>
+FactoryStats GenericFactory<Base>::stats() {
+  return Instrumentation<Base>::snapshot(
+      [](const void* const info) {
+        return static_cast<const ClassInfo<Base>*>(info)->name;
+      },
+      [](const void* const property) {
+        return properyMap().nameOf(property);
+      });
+}
+
+template<typename Base>
+RegistryMemory GenericFactory<Base>::freeze() {
+  reflectionMap().readyAll();
+  RegistryMemory memory;
+  memory.before = reflectionMap().bytes() + properyMap().bytes();
+  reflectionMap().freeze();
+  properyMap().compact();
+  memory.after = reflectionMap().bytes() + properyMap().bytes();
+  return memory;
+}
+
 // Definition to create a object with given name.
 template<typename Base>
-Base* GenericFactory<Base>::create(const std::string& name) {
+Base* GenericFactory<Base>::create(std::string_view name) {
+  const HelperClassMap<Base>& map = reflectionMap();
+  if (map.frozen()) {
+    // The slot has all it takes, the ClassInfo isnt touched.
+    const typename HelperClassMap<Base>::Slot* slot = map.findFrozen(name);
+    if (!slot) {
+      Instrumentation<Base>::countClassMiss();
+      report(reflectionMap().missing(name), name);
+      return nullptr;
+    }
+    typename Instrumentation<Base>::Sample sample(Operation::kCreate);
+    Instrumentation<Base>::countCreate(slot->info);
+    if (!slot->create)
+      return slot->info->clone(slot->info->prototype.get());
+    return slot->create();
+  }
   // Thanks to registerClass only constructable objects will be called here.
-  return creationHelper(name, reflectionMap(), SpecialCase());
+  Base* obj = creationHelper(reflectionMap().find(name));
+  if (!obj)
+    report(reflectionMap().missing(name), name);
+  return obj;
+}
+
+template<typename Base>
+Base* GenericFactory<Base>::clone(const Base* const objPtr) {
+  const ClassInfo<Base>* info = reflectionMap().find(objPtr);
+  if (!info) {
+    report(ErrorCode::kNotRegistered, typeid(*objPtr).name());
+    return nullptr;
+  }
+  if (!info->clone) {
+    report(ErrorCode::kNotCopyable, info->name);
+    return nullptr;
+  }
+  typename Instrumentation<Base>::Sample sample(Operation::kCreate);
+  Instrumentation<Base>::countCreate(info);
+  return info->clone(objPtr);
+}
+
+template<typename Base>
+void GenericFactory<Base>::registerPreset(
+      const std::string& presetName,
+      Base* const prototype) {
+  std::unique_ptr<const Base> owned(prototype);
+  if (reflectionMap().frozen()) {
+    report(ErrorCode::kFrozen, presetName);
+    return;
+  }
+  const ClassInfo<Base>* info = reflectionMap().find(prototype);
+  if (!info) {
+    report(ErrorCode::kNotRegistered, typeid(*prototype).name());
+    return;
+  }
+  if (!info->clone) {
+    report(ErrorCode::kNotCopyable, info->name);
+    return;
+  }
+  ClassInfo<Base>* preset = new ClassInfo<Base>{presetName, info->type,
+      info->size, info->alignment, info->create, info->construct,
+      info->clone, info->copy, ClassId::kUnknown, std::move(owned)};
+  const std::string* taken =
+      reflectionMap().insert(hashName(presetName), preset);
+  if (taken && *taken != presetName)
+    report(ErrorCode::kHashCollision, presetName);
+  else if (taken)
+    report(ErrorCode::kDuplicateClass, presetName);
+}
+
+template<typename Base>
+ErrorCode GenericFactory<Base>::tryCreate(
+        std::string_view name,
+        Base** const objPtr) {
+  *objPtr = creationHelper(reflectionMap().find(name));
+  return *objPtr ? ErrorCode::kNone : reflectionMap().missing(name);
+}
+
+template<typename Base>
+Base* GenericFactory<Base>::create(
+        std::string_view name,
+        MonotonicArena* const arena) {
+  const ClassInfo<Base>* info = reflectionMap().find(name);
+  if (!info) {
+    Instrumentation<Base>::countClassMiss();
+    report(reflectionMap().missing(name), name);
+    return nullptr;
+  }
+  typename Instrumentation<Base>::Sample sample(Operation::kCreate);
+  Instrumentation<Base>::countCreate(info);
+  Base* obj = helpConstruct(info,
+        arena->allocate(info->size, info->alignment));
+  arena->onReset([](void* objPtr) {
+    static_cast<Base*>(objPtr)->~Base();
+  }, obj);
+  return obj;
+}
+
+template<typename Base>
+Base* GenericFactory<Base>::create(
+        std::string_view name,
+        ObjectPool* const pool) {
+  const ClassInfo<Base>* info = reflectionMap().find(name);
+  if (!info) {
+    Instrumentation<Base>::countClassMiss();
+    report(reflectionMap().missing(name), name);
+    return nullptr;
+  }
+  typename Instrumentation<Base>::Sample sample(Operation::kCreate);
+  Instrumentation<Base>::countCreate(info);
+  return helpConstruct(info, pool->allocate(info->size, info->alignment));
+}
+
+template<typename Base>
+void GenericFactory<Base>::release(Base* const objPtr, ObjectPool* const pool) {
+  const ClassInfo<Base>* info = reflectionMap().find(objPtr);
+  if (!info) {
+    report(ErrorCode::kNotRegistered, typeid(*objPtr).name());
+    return;
+  }
+  // The block starts at the most derived object.
+  void* memory = dynamic_cast<void*>(objPtr);
+  objPtr->~Base();
+  pool->deallocate(memory, info->size, info->alignment);
+}
+
+/// Constructs count objects of info back to back in memory. If a
+/// constructor throws the ones constructed so far are destroyed.
+template<typename Base>
+void helpConstructMany(
+      const ClassInfo<Base>* info,
+      char* const memory,
+      std::size_t count,
+      Base** const objPtrs) {
+  std::size_t i = 0;
+  try {
+    for (; i < count; ++i)
+      objPtrs[i] = helpConstruct(info, memory + i * info->size);
+  } catch (...) {
+    while (i)
+      objPtrs[--i]->~Base();
+    throw;
+  }
+}
+
+template<typename Base>
+std::size_t GenericFactory<Base>::createMany(
+        std::string_view name,
+        std::size_t count,
+        Base** const objPtrs) {
+  const ClassInfo<Base>* info = reflectionMap().find(name);
+  if (!info) {
+    Instrumentation<Base>::countClassMiss();
+    report(reflectionMap().missing(name), name);
+    return 0;
+  }
+  if (!count)
+    return 0;
+  if (count > SIZE_MAX / info->size)
+    throw std::bad_array_new_length();
+  Instrumentation<Base>::countCreate(info, count);
+  // sizeof is a multiple of alignof, so every object is aligned.
+  char* memory = static_cast<char*>(::operator new(
+        info->size * count, std::align_val_t(info->alignment)));
+  try {
+    helpConstructMany(info, memory, count, objPtrs);
+  } catch (...) {
+    ::operator delete(memory, std::align_val_t(info->alignment));
+    throw;
+  }
+  return count;
+}
+
+template<typename Base>
+std::size_t GenericFactory<Base>::createMany(
+        std::string_view name,
+        std::size_t count,
+        Base** const objPtrs,
+        MonotonicArena* const arena) {
+  const ClassInfo<Base>* info = reflectionMap().find(name);
+  if (!info) {
+    Instrumentation<Base>::countClassMiss();
+    report(reflectionMap().missing(name), name);
+    return 0;
+  }
+  if (!count)
+    return 0;
+  if (count > SIZE_MAX / info->size)
+    throw std::bad_array_new_length();
+  Instrumentation<Base>::countCreate(info, count);
+  char* memory = static_cast<char*>(
+        arena->allocate(info->size * count, info->alignment));
+  helpConstructMany(info, memory, count, objPtrs);
+  // One cleanup for all of them. Base sits at the same offset in every
+  // object.
+  struct Batch {
+    char* first;
+    std::size_t size;
+    std::size_t count;
+  };
+  Batch* batch = static_cast<Batch*>(
+        arena->allocate(sizeof(Batch), alignof(Batch)));
+  *batch = Batch{reinterpret_cast<char*>(objPtrs[0]), info->size, count};
+  arena->onReset([](void* batchPtr) {
+    const Batch* batch = static_cast<const Batch*>(batchPtr);
+    for (std::size_t i = 0; i < batch->count; ++i)
+      reinterpret_cast<Base*>(batch->first + i * batch->size)->~Base();
+  }, batch);
+  return count;
+}
+
+template<typename Base>
+void GenericFactory<Base>::destroyMany(
+        Base* const* const objPtrs,
+        std::size_t count) {
+  if (!count)
+    return;
+  const ClassInfo<Base>* info = reflectionMap().find(objPtrs[0]);
+  if (!info) {
+    report(ErrorCode::kNotRegistered, typeid(*objPtrs[0]).name());
+    return;
+  }
+  // The block starts at the most derived first object.
+  void* memory = dynamic_cast<void*>(objPtrs[0]);
+  for (std::size_t i = 0; i < count; ++i)
+    objPtrs[i]->~Base();
+  ::operator delete(memory, std::align_val_t(info->alignment));
+}
+
+template<typename Base>
+template<std::size_t Hash>
+Base* GenericFactory<Base>::create() {
+  Base* obj = creationHelper(reflectionMap().find(Hash));
+  if (!obj)
+    report(ErrorCode::kUnknownClass, std::string_view());
+  return obj;
+}
+
+template<typename Base>
+Base* GenericFactory<Base>::create(HashedName name) {
+  // Only the hash is known, the sink gets a empty name.
+  Base* obj = creationHelper(reflectionMap().find(name.hash));
+  if (!obj)
+    report(ErrorCode::kUnknownClass, std::string_view());
+  return obj;
+}
+
+template<typename Base>
+ClassId GenericFactory<Base>::classId(std::string_view name) {
+  if (const typename HelperClassMap<Base>::Slot* slot =
+        reflectionMap().findFrozen(name))
+    return ClassId(slot->id);
+  const ClassInfo<Base>* info = reflectionMap().find(name);
+  return info ? ClassId(info->id) : ClassId();
+}
+
+template<typename Base>
+PropertyId GenericFactory<Base>::propertyId(std::string_view propName) {
+  return properyMap().idOf(propName);
+}
+
+template<typename Base>
+Base* GenericFactory<Base>::create(ClassId id) {
+  // Only the id is known, the sink gets a empty name.
+  Base* obj = creationHelper(reflectionMap().find(id));
+  if (!obj)
+    report(ErrorCode::kUnknownClass, std::string_view());
+  return obj;
+}
+
+template<typename Base>
+void GenericFactory<Base>::setProperty(
+        PropertyId propId,
+        Base* const objPtr,
+        const std::string& value) {
+  const PropertyHandle<Base>* prop = properyMap().find(objPtr, propId);
+  if (!prop) {
+    Instrumentation<Base>::countPropertyMiss();
+    report(ErrorCode::kUnknownProperty, std::string_view());
+    return;
+  }
+  if (!prop->set(objPtr, value))
+    report(ErrorCode::kBadValue, properyMap().nameOf(propId));
+}
+
+template<typename Base>
+std::string GenericFactory<Base>::getProperty(
+        PropertyId propId,
+        Base* const objPtr) {
+  const PropertyHandle<Base>* prop = properyMap().find(objPtr, propId);
+  if (!prop) {
+    Instrumentation<Base>::countPropertyMiss();
+    report(ErrorCode::kUnknownProperty, std::string_view());
+    return "ERROR";
+  }
+  return prop->get(objPtr);
+}
+
+template<typename Base>
+template<typename T>
+bool GenericFactory<Base>::setProperty(
+        PropertyId propId,
+        Base* const objPtr,
+        const typename NonDeduced<T>::type& value) {
+  const PropertyHandle<Base>* prop = properyMap().find(objPtr, propId);
+  if (!prop || !prop->template setValue<T>(objPtr, value)) {
+    Instrumentation<Base>::countPropertyMiss();
+    report(prop ? ErrorCode::kWrongType : ErrorCode::kUnknownProperty,
+           std::string_view());
+    return false;
+  }
+  return true;
+}
+
+template<typename Base>
+template<typename T>
+T GenericFactory<Base>::getProperty(PropertyId propId, Base* const objPtr) {
+  const PropertyHandle<Base>* prop = properyMap().find(objPtr, propId);
+  if (!prop || !prop->template hasType<T>()) {
+    Instrumentation<Base>::countPropertyMiss();
+    report(prop ? ErrorCode::kWrongType : ErrorCode::kUnknownProperty,
+           std::string_view());
+    return T();
+  }
+  return prop->template getValue<T>(objPtr);
 }
 
 template<typename Base>
@@ -204,11 +1640,37 @@ template<typename Base>
 std::string GenericFactory<Base>::nameOf(const std::string& name) {
   return name;
 }
+
+template<typename Base>
+std::size_t GenericFactory<Base>::hashOf(const char* const name) {
+  return hashName(name);
+}
+
+template<typename Base>
+std::size_t GenericFactory<Base>::hashOf(const std::string& name) {
+  return hashName(name);
+}
+template<typename Base>
+template<std::size_t N>
+std::string GenericFactory<Base>::nameOf(const FixedString<N>& name) {
+  return std::string(name.view());
+}
+
+template<typename Base>
+template<std::size_t N>
+std::size_t GenericFactory<Base>::hashOf(const FixedString<N>& name) {
+  return name.hash();
+}
 #ifndef DISABLELITERALSTRING
 template<typename Base>
 std::string GenericFactory<Base>::nameOf(const literal_str_list& name) {
   return convert_to_string(name);
 }
+
+template<typename Base>
+std::size_t GenericFactory<Base>::hashOf(const literal_str_list& name) {
+  return name.hash();
+}
 #endif  // DISABLELITERALSTRING
 }  // namespace genericfactory
 #endif  // GENERICFACTORY_GENERICFACTORY_IMPL_H_
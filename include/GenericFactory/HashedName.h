@@ -0,0 +1,70 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef GENERICFACTORY_HASHEDNAME_H_
+#define GENERICFACTORY_HASHEDNAME_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>  // NOLINT(build/include_order)
+
+namespace genericfactory {
+/// FNV-1a hash of a name. This is the same hash literal_str_list::hash()
+/// computes while compiling, so composed names like T::name + "_ofD" hash
+/// to the same value as the flat string.
+constexpr std::size_t hashName(std::string_view name) {
+  std::size_t hash =
+      (sizeof(std::size_t) == 8 ? 14695981039346656037u : 2166136261u);
+  for (char c : name) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= (sizeof(std::size_t) == 8 ? 1099511628211u : 16777619u);
+  }
+  return hash;
+}
+
+/// A class name that was hashed beforehand (usually while compiling).
+/// Creating with it skips hashing and comparing the name at runtime.
+struct HashedName {
+  constexpr explicit HashedName(std::size_t nameHash) : hash(nameHash) { }
+  constexpr explicit HashedName(std::string_view name)
+    : hash(hashName(name)) { }
+  std::size_t hash;
+};
+
+/// Dense id of a interned name (see GenericFactory<Base>::classId() and
+/// propertyId()). Ids count up from 0 in the order the names are first
+/// registered. Tag keeps class and property ids apart.
+template<typename Tag>
+struct NameId {
+  static constexpr std::uint32_t kUnknown = 0xFFFFFFFFu;
+  constexpr NameId() : value(kUnknown) { }
+  constexpr explicit NameId(std::uint32_t id) : value(id) { }
+  /// False for the id of a unknown name.
+  constexpr explicit operator bool() const {
+    return value != kUnknown;
+  }
+  std::uint32_t value;
+};
+typedef NameId<struct ClassIdTag> ClassId;
+typedef NameId<struct PropertyIdTag> PropertyId;
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_HASHEDNAME_H_
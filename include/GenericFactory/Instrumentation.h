@@ -0,0 +1,331 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#ifndef GENERICFACTORY_INSTRUMENTATION_H_
+#define GENERICFACTORY_INSTRUMENTATION_H_
+
+#include <array>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+
+#ifdef ENABLEINSTRUMENTATION
+#include <chrono>  // NOLINT(build/include_order)
+#include <mutex>  // NOLINT(build/include_order)
+#include <unordered_map>
+#include <vector>
+#endif  // ENABLEINSTRUMENTATION
+
+namespace genericfactory {
+/// What GenericFactory<Base>::stats() reports. It is only collected if
+/// ENABLEINSTRUMENTATION is defined, otherwise it stays empty.
+struct FactoryStats {
+  /// Bucket i counts calls that took [2^i, 2^(i+1)) nanoseconds.
+  typedef std::array<std::uint64_t, 32> Histogram;
+
+  /// Objects created per class name.
+  std::map<std::string, std::uint64_t> creations;
+  /// Calls per property name.
+  std::map<std::string, std::uint64_t> propertySets;
+  std::map<std::string, std::uint64_t> propertyGets;
+  /// Lookups of names that werent registered.
+  std::uint64_t classMisses = 0;
+  std::uint64_t propertyMisses = 0;
+  /// Sampled latencies.
+  Histogram createLatency = {};
+  Histogram setLatency = {};
+  Histogram getLatency = {};
+  /// Sums of the sampled latencies in nanoseconds.
+  std::uint64_t createLatencySum = 0;
+  std::uint64_t setLatencySum = 0;
+  std::uint64_t getLatencySum = 0;
+
+  /// Writes the stats in the prometheus text format.
+  void dump(FILE* file) const {
+    dumpCounts(file, "genericfactory_creations", "class", creations);
+    dumpCounts(file, "genericfactory_property_sets", "property",
+        propertySets);
+    dumpCounts(file, "genericfactory_property_gets", "property",
+        propertyGets);
+    fprintf(file, "# TYPE genericfactory_class_misses counter\n"
+        "genericfactory_class_misses %" PRIu64 "\n", classMisses);
+    fprintf(file, "# TYPE genericfactory_property_misses counter\n"
+        "genericfactory_property_misses %" PRIu64 "\n", propertyMisses);
+    fprintf(file, "# TYPE genericfactory_latency_ns histogram\n");
+    dumpHistogram(file, "create", createLatency, createLatencySum);
+    dumpHistogram(file, "set", setLatency, setLatencySum);
+    dumpHistogram(file, "get", getLatency, getLatencySum);
+  }
+
+ private:
+  /// Escapes a label value (backslash, double quote and newline).
+  static std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value) {
+      if (c == '\\' || c == '"' || c == '\n')
+        escaped += '\\';
+      escaped += c == '\n' ? 'n' : c;
+    }
+    return escaped;
+  }
+  static void dumpCounts(
+        FILE* file,
+        const char* metric,
+        const char* label,
+        const std::map<std::string, std::uint64_t>& counts) {
+    if (counts.empty())
+      return;
+    fprintf(file, "# TYPE %s counter\n", metric);
+    for (const auto& count : counts) {
+      fprintf(file, "%s{%s=\"%s\"} %" PRIu64 "\n", metric, label,
+          escapeLabel(count.first).c_str(), count.second);
+    }
+  }
+  static void dumpHistogram(
+        FILE* file,
+        const char* operation,
+        const Histogram& histogram,
+        std::uint64_t sum) {
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < histogram.size(); ++i) {
+      if (!histogram[i])
+        continue;
+      cumulative += histogram[i];
+      fprintf(file, "genericfactory_latency_ns_bucket"
+          "{operation=\"%s\",le=\"%" PRIu64 "\"} %" PRIu64 "\n", operation,
+          (std::uint64_t(1) << (i + 1)) - 1, cumulative);
+    }
+    fprintf(file, "genericfactory_latency_ns_bucket"
+        "{operation=\"%s\",le=\"+Inf\"} %" PRIu64 "\n"
+        "genericfactory_latency_ns_sum{operation=\"%s\"} %" PRIu64 "\n"
+        "genericfactory_latency_ns_count{operation=\"%s\"} %" PRIu64 "\n",
+        operation, cumulative, operation, sum, operation, cumulative);
+  }
+};
+
+/// Which latency a sample is taken for.
+enum class Operation {
+  kCreate,
+  kSet,
+  kGet
+};
+
+#ifdef ENABLEINSTRUMENTATION
+/// Collects the counters of GenericFactory<Base>. Every thread counts into
+/// its own shard, only snapshot() locks them all. Classes and properties
+/// are counted by address (they are never freed).
+template<typename Base>
+class Instrumentation {
+ public:
+  /// Every kSampleRate-th call of a thread is timed.
+  static constexpr std::uint32_t kSampleRate = 64;
+
+  /// Times a call (if it is sampled) from construction to destruction.
+  class Sample {
+   public:
+    explicit Sample(Operation operation) : m_Operation(operation) {
+      Shard& own = shard();
+      if (++own.calls % kSampleRate == 0)
+        m_Start = std::chrono::steady_clock::now();
+    }
+    ~Sample() {
+      if (m_Start == std::chrono::steady_clock::time_point())
+        return;
+      const auto nanoseconds =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_Start).count();
+      std::size_t bucket = 0;
+      while (bucket + 1 < FactoryStats::Histogram().size()
+             && (2ll << bucket) <= nanoseconds)
+        ++bucket;
+      Shard& own = shard();
+      std::lock_guard<std::mutex> lock(own.mutex);
+      ++own.latency[static_cast<int>(m_Operation)][bucket];
+      own.latencySum[static_cast<int>(m_Operation)] +=
+          static_cast<std::uint64_t>(nanoseconds);
+    }
+
+   private:
+    Operation m_Operation;
+    std::chrono::steady_clock::time_point m_Start;
+  };
+
+  static void countCreate(const void* const cls, std::uint64_t n = 1) {
+    count(&Shard::creations, cls, n);
+  }
+  static void countSet(const void* const property) {
+    count(&Shard::sets, property);
+  }
+  static void countGet(const void* const property) {
+    count(&Shard::gets, property);
+  }
+  static void countClassMiss() {
+    Shard& own = shard();
+    std::lock_guard<std::mutex> lock(own.mutex);
+    ++own.classMisses;
+  }
+  static void countPropertyMiss() {
+    Shard& own = shard();
+    std::lock_guard<std::mutex> lock(own.mutex);
+    ++own.propertyMisses;
+  }
+  /// Sums up all shards. The names are looked up with
+  /// std::string className(const void*) and
+  /// std::string propertyName(const void*).
+  template<typename ClassName, typename PropertyName>
+  static FactoryStats snapshot(
+        ClassName className,
+        PropertyName propertyName) {
+    Registry& all = registry();
+    std::lock_guard<std::mutex> registryLock(all.mutex);
+    FactoryStats stats;
+    addTo(&stats, all.retired, className, propertyName);
+    for (Shard* const shard : all.shards) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      addTo(&stats, *shard, className, propertyName);
+    }
+    return stats;
+  }
+
+ private:
+  typedef std::unordered_map<const void*, std::uint64_t> Counts;
+  struct Shard {
+    std::mutex mutex;
+    Counts creations;
+    Counts sets;
+    Counts gets;
+    std::uint64_t classMisses = 0;
+    std::uint64_t propertyMisses = 0;
+    FactoryStats::Histogram latency[3] = {};
+    std::uint64_t latencySum[3] = {};
+    /// Only touched by the owning thread.
+    std::uint32_t calls = 0;
+  };
+  struct Registry {
+    std::mutex mutex;
+    std::vector<Shard*> shards;
+    /// Counts of threads that are gone.
+    Shard retired;
+  };
+  /// Registers the shard of a thread and keeps its counts when it exits.
+  struct ShardOwner {
+    ShardOwner() {
+      Registry& all = registry();
+      std::lock_guard<std::mutex> lock(all.mutex);
+      all.shards.push_back(&shard);
+    }
+    ~ShardOwner() {
+      Registry& all = registry();
+      std::lock_guard<std::mutex> lock(all.mutex);
+      merge(&all.retired, shard);
+      for (auto it = all.shards.begin(); it != all.shards.end(); ++it) {
+        if (*it == &shard) {
+          all.shards.erase(it);
+          break;
+        }
+      }
+    }
+    Shard shard;
+  };
+  static Registry& registry() {
+    static Registry m_Registry;
+    return m_Registry;
+  }
+  static Shard& shard() {
+    thread_local ShardOwner m_Owner;
+    return m_Owner.shard;
+  }
+  static void count(
+        Counts Shard::*counts,
+        const void* const key,
+        std::uint64_t n = 1) {
+    Shard& own = shard();
+    std::lock_guard<std::mutex> lock(own.mutex);
+    (own.*counts)[key] += n;
+  }
+  static void merge(Shard* const to, const Shard& from) {
+    for (const auto& count : from.creations)
+      to->creations[count.first] += count.second;
+    for (const auto& count : from.sets)
+      to->sets[count.first] += count.second;
+    for (const auto& count : from.gets)
+      to->gets[count.first] += count.second;
+    to->classMisses += from.classMisses;
+    to->propertyMisses += from.propertyMisses;
+    for (int op = 0; op < 3; ++op) {
+      for (std::size_t i = 0; i < from.latency[op].size(); ++i)
+        to->latency[op][i] += from.latency[op][i];
+      to->latencySum[op] += from.latencySum[op];
+    }
+  }
+  template<typename ClassName, typename PropertyName>
+  static void addTo(
+        FactoryStats* const stats,
+        const Shard& shard,
+        ClassName className,
+        PropertyName propertyName) {
+    for (const auto& count : shard.creations)
+      stats->creations[className(count.first)] += count.second;
+    for (const auto& count : shard.sets)
+      stats->propertySets[propertyName(count.first)] += count.second;
+    for (const auto& count : shard.gets)
+      stats->propertyGets[propertyName(count.first)] += count.second;
+    stats->classMisses += shard.classMisses;
+    stats->propertyMisses += shard.propertyMisses;
+    FactoryStats::Histogram* latencies[3] = {
+      &stats->createLatency, &stats->setLatency, &stats->getLatency
+    };
+    std::uint64_t* sums[3] = {
+      &stats->createLatencySum, &stats->setLatencySum, &stats->getLatencySum
+    };
+    for (int op = 0; op < 3; ++op) {
+      for (std::size_t i = 0; i < shard.latency[op].size(); ++i)
+        (*latencies[op])[i] += shard.latency[op][i];
+      *sums[op] += shard.latencySum[op];
+    }
+  }
+};
+#else
+/// Does nothing, see above. Every call compiles to nothing.
+template<typename Base>
+class Instrumentation {
+ public:
+  class Sample {
+   public:
+    explicit Sample(Operation) { }
+  };
+  static void countCreate(const void* const, std::uint64_t = 1) { }
+  static void countSet(const void* const) { }
+  static void countGet(const void* const) { }
+  static void countClassMiss() { }
+  static void countPropertyMiss() { }
+  template<typename ClassName, typename PropertyName>
+  static FactoryStats snapshot(ClassName, PropertyName) {
+    return FactoryStats();
+  }
+};
+#endif  // ENABLEINSTRUMENTATION
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_INSTRUMENTATION_H_
@@ -23,12 +23,12 @@ class literal_str_list {
       (sizeof(std::size_t) == 8 ? 1099511628211u : 16777619u);
   static constexpr std::size_t fnv_offset =
       (sizeof(std::size_t) == 8 ? 14695981039346656037u : 2166136261u);
+  // Hash of the head followed by the first i characters of this text.
   constexpr std::size_t fnv_1a_hash(unsigned int i) const {
     return (i == 0 ?
-        (head != nullptr ?
-         ((head->fnv_1a_hash(head->text_size-1) ^ text_ptr[0]) * fnv_prime) :
-         fnv_offset) :
-        ((fnv_1a_hash(i-1) ^ text_ptr[i]) * fnv_prime));
+        (head != nullptr ? head->hash() : fnv_offset) :
+        ((fnv_1a_hash(i-1) ^ static_cast<unsigned char>(text_ptr[i-1]))
+         * fnv_prime));
   }
   template <typename FwdIter>
   void copy_to_recurse(FwdIter& beg, FwdIter end) const {  // NOLINT
@@ -71,7 +71,7 @@ class literal_str_list {
     return literal_str_list(aHead.text_ptr, aHead.text_size, this);
   }
   constexpr std::size_t hash() const {
-    return fnv_1a_hash(text_size-1);
+    return fnv_1a_hash(text_size);
   }
   template <typename FwdIter>
   void copy_to(FwdIter beg, FwdIter end) const {
@@ -0,0 +1,258 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#ifndef GENERICFACTORY_PARALLEL_H_
+#define GENERICFACTORY_PARALLEL_H_
+
+#include <atomic>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "GenericFactory/GenericFactory_impl.h"
+
+namespace genericfactory {
+/// A object to create: its class and the values of its properties (as
+/// given to setProperty).
+struct ObjectSpec {
+  std::string className;
+  std::vector<std::pair<std::string, std::string> > properties;
+};
+
+/// Hands out the indices [0, count) to a fixed number of workers. Every
+/// worker takes small chunks from the front of its own range and steals the
+/// back half of another range once its own is empty.
+class WorkRanges {
+ public:
+  /// Items a worker takes from its own range at once.
+  static const std::uint32_t kChunk = 16;
+
+  WorkRanges(std::uint32_t count, unsigned workers) : m_Ranges(workers) {
+    for (unsigned i = 0; i < workers; ++i) {
+      m_Ranges[i].value.store(pack(
+            static_cast<std::uint32_t>(std::uint64_t(count) * i / workers),
+            static_cast<std::uint32_t>(std::uint64_t(count) * (i + 1) / workers)),
+          std::memory_order_relaxed);
+    }
+  }
+
+  /// Writes the next items of worker to [*begin, *end). Returns false if
+  /// there is nothing left to take or steal.
+  bool next(unsigned worker, std::uint32_t* begin, std::uint32_t* end) {
+    if (takeFront(worker, begin, end))
+      return true;
+    const unsigned workers = static_cast<unsigned>(m_Ranges.size());
+    for (unsigned i = 1; i < workers; ++i) {
+      if (stealBack((worker + i) % workers, worker))
+        return takeFront(worker, begin, end);
+    }
+    return false;
+  }
+
+ private:
+  static std::uint64_t pack(std::uint32_t begin, std::uint32_t end) {
+    return (std::uint64_t(begin) << 32) | end;
+  }
+  bool takeFront(unsigned worker, std::uint32_t* begin, std::uint32_t* end) {
+    std::atomic<std::uint64_t>& range = m_Ranges[worker].value;
+    std::uint64_t packed = range.load(std::memory_order_relaxed);
+    for (;;) {
+      const std::uint32_t first = packed >> 32;
+      const std::uint32_t last = static_cast<std::uint32_t>(packed);
+      if (first >= last)
+        return false;
+      const std::uint32_t taken = last - first < kChunk ? last : first + kChunk;
+      if (range.compare_exchange_weak(packed, pack(taken, last),
+            std::memory_order_relaxed)) {
+        *begin = first;
+        *end = taken;
+        return true;
+      }
+    }
+  }
+  /// Moves the back half of victims range to the (empty) range of thief.
+  bool stealBack(unsigned victim, unsigned thief) {
+    std::atomic<std::uint64_t>& range = m_Ranges[victim].value;
+    std::uint64_t packed = range.load(std::memory_order_relaxed);
+    for (;;) {
+      const std::uint32_t first = packed >> 32;
+      const std::uint32_t last = static_cast<std::uint32_t>(packed);
+      if (last <= first || last - first < 2)
+        return false;
+      const std::uint32_t middle = first + (last - first) / 2;
+      if (range.compare_exchange_weak(packed, pack(first, middle),
+            std::memory_order_relaxed)) {
+        m_Ranges[thief].value.store(pack(middle, last),
+              std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+  /// One cache line per range, workers dont share lines.
+  struct alignas(64) Range {
+    std::atomic<std::uint64_t> value;
+  };
+  std::vector<Range> m_Ranges;
+};
+
+/// Threads that run the workers of createParallel, one per core besides the
+/// calling thread. Started on the first use and kept until the programm
+/// terminates, so a call doesnt pay for starting threads.
+class WorkerPool {
+ public:
+  static WorkerPool& instance() {
+    static WorkerPool m_Pool;
+    return m_Pool;
+  }
+  /// Most workers run() uses, the calling thread included.
+  unsigned size() const {
+    return static_cast<unsigned>(m_Threads.size()) + 1;
+  }
+  /// Calls work(worker) for every worker in [0, workers) (at most size()),
+  /// worker 0 on the calling thread. Returns once all returned. Called from
+  /// a worker it only runs worker 0, work has to cope with that (see
+  /// WorkRanges).
+  template<typename Work>
+  void run(unsigned workers, Work& work) {
+    if (inWorker() || workers < 2 || m_Threads.empty()) {
+      work(0u);
+      return;
+    }
+    std::lock_guard<std::mutex> running(m_RunMutex);
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Call = [](void* const context, unsigned worker) {
+        (*static_cast<Work*>(context))(worker);
+      };
+      m_Context = &work;
+      m_Workers = workers < size() ? workers : size();
+      m_Pending = m_Workers - 1;
+      ++m_Generation;
+    }
+    m_Wake.notify_all();
+    inWorker() = true;
+    work(0u);
+    inWorker() = false;
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Done.wait(lock, [this] { return !m_Pending; });
+  }
+
+ private:
+  WorkerPool() {
+    const unsigned cores = std::thread::hardware_concurrency();
+    for (unsigned i = 1; i < cores; ++i)
+      m_Threads.emplace_back(&WorkerPool::loop, this, i);
+  }
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Stop = true;
+    }
+    m_Wake.notify_all();
+    for (std::thread& thread : m_Threads)
+      thread.join();
+  }
+  static bool& inWorker() {
+    thread_local bool m_InWorker = false;
+    return m_InWorker;
+  }
+  void loop(unsigned worker) {
+    inWorker() = true;
+    std::uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;) {
+      m_Wake.wait(lock, [this, seen] {
+        return m_Stop || m_Generation != seen;
+      });
+      if (m_Stop)
+        return;
+      seen = m_Generation;
+      if (worker >= m_Workers)
+        continue;
+      lock.unlock();
+      m_Call(m_Context, worker);
+      lock.lock();
+      if (!--m_Pending)
+        m_Done.notify_one();
+    }
+  }
+
+  std::vector<std::thread> m_Threads;
+  /// One run at a time.
+  std::mutex m_RunMutex;
+  /// Guards the run below.
+  std::mutex m_Mutex;
+  std::condition_variable m_Wake;
+  std::condition_variable m_Done;
+  void (*m_Call)(void* const context, unsigned worker) = nullptr;
+  void* m_Context = nullptr;
+  unsigned m_Workers = 0;
+  unsigned m_Pending = 0;
+  std::uint64_t m_Generation = 0;
+  bool m_Stop = false;
+};
+
+/// Creates the objects of specs on threads workers (the calling thread is
+/// one of them, 0 uses every core) and sets their properties there, values
+/// are converted by StringCastHelper on the worker. Returns the objects in
+/// the order of specs, nullptr for unknown classes (reported like create()).
+/// The workers run on WorkerPool, there are never more than cores and every
+/// one gets at least kMinPerWorker specs: below that handing them out costs
+/// more than it saves.
+template<typename Base>
+std::vector<Base*> createParallel(
+      const std::vector<ObjectSpec>& specs,
+      unsigned threads = 0) {
+  const std::size_t kMinPerWorker = 256;
+  std::vector<Base*> objPtrs(specs.size());
+  WorkerPool& pool = WorkerPool::instance();
+  if (!threads || threads > pool.size())
+    threads = pool.size();
+  const std::size_t most = specs.size() / kMinPerWorker;
+  if (threads > most)
+    threads = most ? static_cast<unsigned>(most) : 1;
+  WorkRanges ranges(static_cast<std::uint32_t>(specs.size()), threads);
+  auto work = [&](unsigned worker) {
+    std::uint32_t begin;
+    std::uint32_t end;
+    while (ranges.next(worker, &begin, &end)) {
+      for (std::uint32_t i = begin; i < end; ++i) {
+        Base* obj = GenericFactory<Base>::create(specs[i].className);
+        if (obj) {
+          for (const auto& property : specs[i].properties)
+            GenericFactory<Base>::setProperty(property.first, obj,
+                                              property.second);
+        }
+        objPtrs[i] = obj;
+      }
+    }
+  };
+  pool.run(threads, work);
+  return objPtrs;
+}
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_PARALLEL_H_
@@ -24,92 +24,595 @@
 #ifndef GENERICFACTORY_PROPERTY_H_
 #define GENERICFACTORY_PROPERTY_H_
 
+#include <any>  // NOLINT(build/include_order)
+#include <charconv>  // NOLINT(build/include_order)
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "./Diagnostics.h"
+#include "./Instrumentation.h"
+#include "./Serialization.h"
 
 namespace genericfactory {
 /// A property consists of getter and setter.
 template<typename Base>
 class Property {
  public:
-  virtual void set(Base* const obj, const std::string& value) const = 0;
-  virtual std::string get(const Base* const obj) const = 0;
+  /// Sets / gets the value as string on the subobject of the class that
+  /// owns the property (see ownerOffset), no casts are needed. setAt returns
+  /// false and leaves owner as it is if value cant be parsed.
+  virtual bool setAt(void* const owner, const std::string& value) const = 0;
+  virtual std::string getAt(const void* const owner) const = 0;
+  /// Writes the byte offset from obj to the subobject of the owning class to
+  /// offset. Returns false if obj doesnt derive from the owning class.
+  /// The offset is the same for all objects of one dynamic type.
+  virtual bool ownerOffset(
+        const Base* const obj,
+        std::ptrdiff_t* const offset) const = 0;
+  /// The class that registered this property.
+  virtual const std::type_info& ownerType() const = 0;
+  /// Bytes of the owning class (see HelperDataSize). With ownerOffset it
+  /// tells which owners of a object are bases of which (see
+  /// HelperPropertyMap::resolve()).
+  virtual std::size_t ownerSize() const = 0;
+  /// The type of the value (as taken by the setter).
+  virtual const std::type_info& valueType() const = 0;
+  /// Converts value with StringCastHelper once, to be set with setParsedAt
+  /// as often as needed. Empty if value cant be parsed.
+  virtual std::any parse(const std::string& value) const = 0;
+  virtual void setParsedAt(void* const owner, const std::any& parsed) const = 0;
+  /// Appends the value to writer (see BinaryCastHelper) / sets the value
+  /// from bytes written that way. readAt returns false for bad bytes.
+  virtual void writeAt(
+        const void* const owner,
+        BinaryWriter* const writer) const = 0;
+  virtual bool readAt(void* const owner, std::string_view bytes) const = 0;
+  /// Copies the value from the owner subobject from to the one of to.
+  virtual void copyAt(const void* const from, void* const to) const = 0;
+  /// Returns the address of the data member in owner if the property is
+  /// bound to one (see FieldProperty), nullptr if it has a setter/getter.
+  virtual const void* fieldAt(const void* const) const {
+    return nullptr;
+  }
   virtual ~Property() { }
 };
 
+/// A property with known ValueType. Values can be get/set without going
+/// through StringCastHelper.
+template<typename Base, typename ValueType>
+class ValueProperty : public Property<Base> {
+ public:
+  /// Same as setAt/getAt without strings.
+  virtual void setValueAt(void* const owner, ValueType value) const = 0;
+  virtual ValueType getValueAt(const void* const owner) const = 0;
+  virtual const std::type_info& valueType() const override {
+    return typeid(ValueType);
+  }
+};
+
+/// Used to make callers of typed get/set state the type explicitly.
+template<typename T>
+struct NonDeduced {
+  typedef T type;
+};
+
+/// Bytes of C without the tail padding a subclass may put its members in,
+/// where the first member of a subclass goes. sizeof(C) if C is final.
+template<typename C, bool = std::is_final<C>::value>
+struct HelperDataSize {
+  struct Probe : C {
+    char next;
+  };
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+// Conditionally supported for classes that arent standard layout, fine
+// without virtual bases.
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif  // __GNUC__
+  static constexpr std::size_t value = offsetof(Probe, next);
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif  // __GNUC__
+};
+template<typename C>
+struct HelperDataSize<C, true> {
+  static constexpr std::size_t value = sizeof(C);
+};
+
+/// A property resolved for one dynamic type (see
+/// GenericFactory<Base>::findProperty). It is cheap to copy and doesnt look
+/// up anything when used, which makes it the way to go in loops.
+/// It stays valid until the property is registered again.
+template<typename Base>
+class PropertyHandle {
+ public:
+  /// The empty handle. Returned if no property was found.
+  PropertyHandle() = default;
+  /// Resolves pProperty for the dynamic type of obj, pOffset is the one
+  /// returned by ownerOffset().
+  PropertyHandle(const Property<Base>* const pProperty,
+                 const Base* const obj,
+                 std::ptrdiff_t pOffset)
+    : property(pProperty),
+      offset(pOffset),
+      type(&typeid(*obj)) {
+    const void* member =
+        property->fieldAt(reinterpret_cast<const char*>(obj) + offset);
+    if (member) {
+      field = static_cast<const char*>(member)
+          - reinterpret_cast<const char*>(obj);
+    }
+  }
+
+  explicit operator bool() const {
+    return property != nullptr;
+  }
+  /// Returns true if obj has the dynamic type the handle was resolved for.
+  bool appliesTo(const Base* const obj) const {
+    return property && typeid(*obj) == *type;
+  }
+  /// Sets the value. Returns false if the handle doesnt apply to obj or the
+  /// value cant be parsed, obj isnt changed then.
+  bool set(Base* const obj, const std::string& value) const {
+    if (!appliesTo(obj))
+      return false;
+    typename Instrumentation<Base>::Sample sample(Operation::kSet);
+    Instrumentation<Base>::countSet(property);
+    return property->setAt(reinterpret_cast<char*>(obj) + offset, value);
+  }
+  /// Returns the value or "ERROR" if the handle doesnt apply to obj.
+  std::string get(const Base* const obj) const {
+    if (!appliesTo(obj))
+      return "ERROR";
+    typename Instrumentation<Base>::Sample sample(Operation::kGet);
+    Instrumentation<Base>::countGet(property);
+    return property->getAt(reinterpret_cast<const char*>(obj) + offset);
+  }
+  /// Converts value once for setParsed (empty if the handle is empty or
+  /// value cant be parsed).
+  std::any parse(const std::string& value) const {
+    if (!property)
+      return std::any();
+    return property->parse(value);
+  }
+  /// Sets a value returned by parse. Returns false if the handle doesnt
+  /// apply to obj.
+  bool setParsed(Base* const obj, const std::any& parsed) const {
+    if (!appliesTo(obj))
+      return false;
+    typename Instrumentation<Base>::Sample sample(Operation::kSet);
+    Instrumentation<Base>::countSet(property);
+    property->setParsedAt(reinterpret_cast<char*>(obj) + offset, parsed);
+    return true;
+  }
+  /// Binary versions of get/set (see BinaryCastHelper). write returns false
+  /// if the handle doesnt apply to obj, read also if bytes are bad.
+  bool write(const Base* const obj, BinaryWriter* const writer) const {
+    if (!appliesTo(obj))
+      return false;
+    typename Instrumentation<Base>::Sample sample(Operation::kGet);
+    Instrumentation<Base>::countGet(property);
+    property->writeAt(reinterpret_cast<const char*>(obj) + offset, writer);
+    return true;
+  }
+  bool read(Base* const obj, std::string_view bytes) const {
+    if (!appliesTo(obj))
+      return false;
+    typename Instrumentation<Base>::Sample sample(Operation::kSet);
+    Instrumentation<Base>::countSet(property);
+    return property->readAt(reinterpret_cast<char*>(obj) + offset, bytes);
+  }
+  /// Copies the value from one object to another, both of the type the
+  /// handle applies to. Trivially copyable fields are copied with memcpy.
+  bool copy(const Base* const from, Base* const to) const {
+    if (!appliesTo(from) || !appliesTo(to))
+      return false;
+    property->copyAt(reinterpret_cast<const char*>(from) + offset,
+                     reinterpret_cast<char*>(to) + offset);
+    return true;
+  }
+  /// Returns true if the property is bound to a data member.
+  bool isField() const {
+    return field != kNoField;
+  }
+  /// Returns true if the value of the property has type T.
+  template<typename T>
+  bool hasType() const {
+    return property && property->valueType() == typeid(T);
+  }
+  /// Typed versions of set/get, e.g. setValue<float>(obj, 1.0f). T has to be
+  /// the exact type of the property. setValue returns false if it isnt (or if
+  /// the handle doesnt apply to obj), getValue returns T().
+  template<typename T>
+  bool setValue(
+        Base* const obj,
+        const typename NonDeduced<T>::type& value) const {
+    if (!appliesTo(obj) || !hasType<T>())
+      return false;
+    typename Instrumentation<Base>::Sample sample(Operation::kSet);
+    Instrumentation<Base>::countSet(property);
+    if (isField()) {
+      // A plain store, no call.
+      *reinterpret_cast<T*>(reinterpret_cast<char*>(obj) + field) = value;
+      return true;
+    }
+    static_cast<const ValueProperty<Base, T>*>(property)->setValueAt(
+          reinterpret_cast<char*>(obj) + offset, value);
+    return true;
+  }
+  template<typename T>
+  T getValue(const Base* const obj) const {
+    if (!appliesTo(obj) || !hasType<T>())
+      return T();
+    typename Instrumentation<Base>::Sample sample(Operation::kGet);
+    Instrumentation<Base>::countGet(property);
+    if (isField())
+      return *reinterpret_cast<const T*>(
+            reinterpret_cast<const char*>(obj) + field);
+    return static_cast<const ValueProperty<Base, T>*>(property)->getValueAt(
+          reinterpret_cast<const char*>(obj) + offset);
+  }
+
+ private:
+  static constexpr std::ptrdiff_t kNoField = PTRDIFF_MIN;
+  const Property<Base>* property = nullptr;
+  /// From the object to the subobject of the class owning the property.
+  std::ptrdiff_t offset = 0;
+  /// From the object to the data member, kNoField if there is none.
+  std::ptrdiff_t field = kNoField;
+  const std::type_info* type = nullptr;
+};
+
 /// Helper struct to partially specialize.
+/// Arithmetic types, bool, enums (as their underlying number) and
+/// std::string are converted without specializing. Numbers go through
+/// std::to_chars/std::from_chars: no locale, no allocation while parsing,
+/// and floating point values round-trip exactly.
 template<typename ValueType>
 struct StringCastHelper {
  public:
   /// Returns the value of the property as string.
   static std::string toString(const ValueType& value);
 
-  /// Returns the value from string.
+  /// Returns the value from string. Values that cant be parsed give
+  /// ValueType(), use parse() to tell them apart. Setting a property reports
+  /// them with the name of the property (kBadValue).
   static ValueType fromString(const std::string& value);
 
+  /// Parses the whole text into *value without allocating (for the built in
+  /// types). Returns false if it isnt a valid value.
+  static bool parse(std::string_view text, ValueType* const value);
+
  private:
   /// Hide the Constructor.
   StringCastHelper();
 };
 
-/// Proeprty specialized for one ValueType.
-template<typename Base, typename OwnerClass, typename ValueType>
-class TypeProperty : public Property<Base> {
+/// Converts values for BinaryWriter/BinaryReader. Arithmetic types, bool
+/// and enums are copied as raw bytes, std::string as its characters.
+/// Other types go through StringCastHelper (specialize this to avoid it).
+template<typename ValueType>
+struct BinaryCastHelper {
+ public:
+  static void write(const ValueType& value, BinaryWriter* const writer) {
+    if constexpr (std::is_arithmetic<ValueType>::value
+                  || std::is_enum<ValueType>::value) {
+      writer->write(&value, sizeof(value));
+    } else if constexpr (std::is_same<ValueType, std::string>::value) {
+      writer->write(value.data(), value.size());
+    } else {
+      const std::string text = StringCastHelper<ValueType>::toString(value);
+      writer->write(text.data(), text.size());
+    }
+  }
+  static bool read(std::string_view bytes, ValueType* const value) {
+    if constexpr (std::is_arithmetic<ValueType>::value
+                  || std::is_enum<ValueType>::value) {
+      if (bytes.size() != sizeof(ValueType))
+        return false;
+      std::memcpy(value, bytes.data(), sizeof(ValueType));
+      return true;
+    } else {
+      return StringCastHelper<ValueType>::parse(bytes, value);
+    }
+  }
+
+ private:
+  /// Hide the Constructor.
+  BinaryCastHelper();
+};
+
+/// Proeprty specialized for one ValueType. The setter may take the value
+/// by value, const reference or rvalue reference (SetArg), the getter may
+/// return it by value or const reference (GetResult). Parsed values are
+/// moved into the setter, values got by reference arent copied unless
+/// needed.
+template<typename Base, typename OwnerClass, typename ValueType,
+         typename SetArg = ValueType, typename GetResult = ValueType>
+class TypeProperty : public ValueProperty<Base, ValueType> {
  public:
   /// Constructor setting the getter and setter ptr.
-  TypeProperty(void (OwnerClass::*pSetter)(ValueType value),
-               ValueType (OwnerClass::*pGetter)() const)
+  TypeProperty(void (OwnerClass::*pSetter)(SetArg value),
+               GetResult (OwnerClass::*pGetter)() const)
     : setterPtr(pSetter),
       getterPtr(pGetter) { }
 
-  virtual void set(Base* const obj, const std::string& value) const override {
-    OwnerClass* const me = dynamic_cast<OwnerClass* const>(obj);
-    if (me) {
-      setValue(me, StringCastHelper<ValueType>::fromString(value));
+  virtual bool setAt(
+        void* const owner,
+        const std::string& value) const override {
+    ValueType parsed = ValueType();
+    if (!StringCastHelper<ValueType>::parse(value, &parsed))
+      return false;
+    setValue(static_cast<OwnerClass*>(owner), std::move(parsed));
+    return true;
+  }
+  virtual std::string getAt(const void* const owner) const override {
+    return StringCastHelper<ValueType>::toString(
+          getValue(static_cast<const OwnerClass*>(owner)));
+  }
+  virtual bool ownerOffset(
+        const Base* const obj,
+        std::ptrdiff_t* const offset) const override {
+    const OwnerClass* const me = dynamic_cast<const OwnerClass* const>(obj);
+    if (!me)
+      return false;
+    *offset = reinterpret_cast<const char*>(me)
+        - reinterpret_cast<const char*>(obj);
+    return true;
+  }
+  virtual const std::type_info& ownerType() const override {
+    return typeid(OwnerClass);
+  }
+  virtual std::size_t ownerSize() const override {
+    return HelperDataSize<OwnerClass>::value;
+  }
+  virtual void setValueAt(
+        void* const owner,
+        ValueType value) const override {
+    setValue(static_cast<OwnerClass*>(owner), std::move(value));
+  }
+  virtual ValueType getValueAt(const void* const owner) const override {
+    return getValue(static_cast<const OwnerClass*>(owner));
+  }
+  virtual std::any parse(const std::string& value) const override {
+    ValueType parsed = ValueType();
+    if (!StringCastHelper<ValueType>::parse(value, &parsed))
+      return std::any();
+    return std::any(std::move(parsed));
+  }
+  virtual void setParsedAt(
+        void* const owner,
+        const std::any& parsed) const override {
+    // Parsed values are set on many objects, they are copied.
+    const ValueType* value = std::any_cast<ValueType>(&parsed);
+    if (value) {
+      setValue(static_cast<OwnerClass*>(owner), *value);
       return;
     }
-    perror("Cant call this prop on this Object!\n");
+    report(ErrorCode::kNotParsed, typeid(ValueType).name());
   }
-  virtual std::string get(const Base* const obj) const override {
-    const OwnerClass* const me = dynamic_cast<const OwnerClass* const>(obj);
-    if (me)
-      return StringCastHelper<ValueType>::toString(getValue(me));
-    perror("Cant call this prop on this Object!\n");
-    return "ERRORINPROP";
+  virtual void writeAt(
+        const void* const owner,
+        BinaryWriter* const writer) const override {
+    BinaryCastHelper<ValueType>::write(
+          getValue(static_cast<const OwnerClass*>(owner)), writer);
+  }
+  virtual bool readAt(
+        void* const owner,
+        std::string_view bytes) const override {
+    ValueType value = ValueType();
+    if (!BinaryCastHelper<ValueType>::read(bytes, &value))
+      return false;
+    setValue(static_cast<OwnerClass*>(owner), std::move(value));
+    return true;
+  }
+  virtual void copyAt(
+        const void* const from,
+        void* const to) const override {
+    setValue(static_cast<OwnerClass*>(to),
+             getValue(static_cast<const OwnerClass*>(from)));
   }
 
  private:
-  /// Getter for the property.
-  ValueType getValue(const OwnerClass* const objPtr) const {
+  /// Getter for the property. A reference if the getter returns one.
+  GetResult getValue(const OwnerClass* const objPtr) const {
     return (objPtr->*getterPtr)();
   }
 
-  /// Setter for the property.
-  void setValue(OwnerClass* const objPtr, ValueType value) const {
-    (objPtr->*setterPtr)(value);
+  /// Setter for the property. Rvalues are moved into the setter, lvalues
+  /// are copied only if the setter takes a rvalue reference.
+  template<typename Value>
+  void setValue(OwnerClass* const objPtr, Value&& value) const {
+    if constexpr (std::is_rvalue_reference<SetArg>::value
+                  && std::is_lvalue_reference<Value>::value)
+      (objPtr->*setterPtr)(ValueType(value));
+    else
+      (objPtr->*setterPtr)(std::forward<Value>(value));
   }
   /// Saves pointer to the setter (offset to class pointer).
-  void (OwnerClass::*setterPtr)(ValueType value);
+  void (OwnerClass::*setterPtr)(SetArg value);
   /// Saves pointer to the getter (offset to class pointer).
-  ValueType (OwnerClass::*getterPtr)() const;
+  GetResult (OwnerClass::*getterPtr)() const;
+};
+
+/// Property bound to a data member (ValueType OwnerClass::*). Gets and sets
+/// load and store the member, no setter/getter is called. Handles store and
+/// load it without any call (see PropertyHandle::setValue).
+template<typename Base, typename OwnerClass, typename ValueType>
+class FieldProperty : public ValueProperty<Base, ValueType> {
+ public:
+  explicit FieldProperty(ValueType OwnerClass::*pMember)
+    : memberPtr(pMember) { }
+
+  virtual bool setAt(
+        void* const owner,
+        const std::string& value) const override {
+    // parse() only writes valid values.
+    return StringCastHelper<ValueType>::parse(value, &member(owner));
+  }
+  virtual std::string getAt(const void* const owner) const override {
+    return StringCastHelper<ValueType>::toString(member(owner));
+  }
+  virtual bool ownerOffset(
+        const Base* const obj,
+        std::ptrdiff_t* const offset) const override {
+    const OwnerClass* const me = dynamic_cast<const OwnerClass* const>(obj);
+    if (!me)
+      return false;
+    *offset = reinterpret_cast<const char*>(me)
+        - reinterpret_cast<const char*>(obj);
+    return true;
+  }
+  virtual const std::type_info& ownerType() const override {
+    return typeid(OwnerClass);
+  }
+  virtual std::size_t ownerSize() const override {
+    return HelperDataSize<OwnerClass>::value;
+  }
+  virtual void setValueAt(
+        void* const owner,
+        ValueType value) const override {
+    member(owner) = std::move(value);
+  }
+  virtual ValueType getValueAt(const void* const owner) const override {
+    return member(owner);
+  }
+  virtual std::any parse(const std::string& value) const override {
+    ValueType parsed = ValueType();
+    if (!StringCastHelper<ValueType>::parse(value, &parsed))
+      return std::any();
+    return std::any(std::move(parsed));
+  }
+  virtual void setParsedAt(
+        void* const owner,
+        const std::any& parsed) const override {
+    const ValueType* value = std::any_cast<ValueType>(&parsed);
+    if (value) {
+      member(owner) = *value;
+      return;
+    }
+    report(ErrorCode::kNotParsed, typeid(ValueType).name());
+  }
+  /// The member is written and read in place, without a copy.
+  virtual void writeAt(
+        const void* const owner,
+        BinaryWriter* const writer) const override {
+    BinaryCastHelper<ValueType>::write(member(owner), writer);
+  }
+  virtual bool readAt(
+        void* const owner,
+        std::string_view bytes) const override {
+    return BinaryCastHelper<ValueType>::read(bytes, &member(owner));
+  }
+  virtual void copyAt(
+        const void* const from,
+        void* const to) const override {
+    if constexpr (std::is_trivially_copyable<ValueType>::value)
+      std::memcpy(&member(to), &member(from), sizeof(ValueType));
+    else
+      member(to) = member(from);
+  }
+  virtual const void* fieldAt(const void* const owner) const override {
+    return &member(owner);
+  }
+
+ private:
+  ValueType& member(void* const owner) const {
+    return static_cast<OwnerClass*>(owner)->*memberPtr;
+  }
+  const ValueType& member(const void* const owner) const {
+    return static_cast<const OwnerClass*>(owner)->*memberPtr;
+  }
+  /// Saves pointer to the member.
+  ValueType OwnerClass::*memberPtr;
 };
 
 // #########################DEFINITIONS#########################################
 
 template<typename ValueType>
-std::string StringCastHelper<ValueType>::toString(const ValueType&) {
-  // this sizeof trick is a lottle bit dirty. But false will allways cause this
-  // exception.
-  static_assert(sizeof(ValueType) != sizeof(ValueType), "Specialize a"
-      "StringCastHelper for your ValueType!");
+std::string StringCastHelper<ValueType>::toString(const ValueType& value) {
+  if constexpr (std::is_same<ValueType, std::string>::value) {
+    return value;
+  } else if constexpr (std::is_same<ValueType, bool>::value) {
+    return value ? "true" : "false";
+  } else if constexpr (std::is_enum<ValueType>::value) {
+    typedef typename std::underlying_type<ValueType>::type Underlying;
+    return StringCastHelper<Underlying>::toString(
+          static_cast<Underlying>(value));
+  } else if constexpr (std::is_arithmetic<ValueType>::value) {
+    // Enough for the shortest round trip of any arithmetic type.
+    char buffer[64];
+    const std::to_chars_result result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+  } else {
+    // this sizeof trick is a lottle bit dirty. But false will allways cause
+    // this exception.
+    static_assert(sizeof(ValueType) != sizeof(ValueType), "Specialize a"
+        "StringCastHelper for your ValueType!");
+  }
 }
 
 template<typename ValueType>
-ValueType StringCastHelper<ValueType>::fromString(const std::string&) {
-  // this sizeof trick is a lottle bit dirty. But false will allways cause this
-  // exception.
-  static_assert(sizeof(ValueType) != sizeof(ValueType), "Specialize a"
-      "StringCastHelper for your ValueType!");
+ValueType StringCastHelper<ValueType>::fromString(const std::string& value) {
+  if constexpr (std::is_same<ValueType, std::string>::value) {
+    return value;
+  } else if constexpr (std::is_arithmetic<ValueType>::value
+                       || std::is_enum<ValueType>::value) {
+    ValueType result = ValueType();
+    parse(value, &result);
+    return result;
+  } else {
+    static_assert(sizeof(ValueType) != sizeof(ValueType), "Specialize a"
+        "StringCastHelper for your ValueType!");
+  }
+}
+
+template<typename ValueType>
+bool StringCastHelper<ValueType>::parse(
+      std::string_view text,
+      ValueType* const value) {
+  if constexpr (std::is_same<ValueType, std::string>::value) {
+    value->assign(text.data(), text.size());
+    return true;
+  } else if constexpr (std::is_same<ValueType, bool>::value) {
+    if (text == "true" || text == "1") {
+      *value = true;
+      return true;
+    }
+    if (text == "false" || text == "0") {
+      *value = false;
+      return true;
+    }
+    return false;
+  } else if constexpr (std::is_enum<ValueType>::value) {
+    typedef typename std::underlying_type<ValueType>::type Underlying;
+    Underlying number;
+    if (!StringCastHelper<Underlying>::parse(text, &number))
+      return false;
+    *value = static_cast<ValueType>(number);
+    return true;
+  } else if constexpr (std::is_arithmetic<ValueType>::value) {
+    const char* end = text.data() + text.size();
+    ValueType number;
+    const std::from_chars_result result =
+        std::from_chars(text.data(), end, number);
+    if (result.ec != std::errc() || result.ptr != end)
+      return false;
+    *value = number;
+    return true;
+  } else {
+    // Specialized types only have fromString.
+    *value = fromString(std::string(text));
+    return true;
+  }
 }
 }  // namespace genericfactory
 #endif  // GENERICFACTORY_PROPERTY_H_
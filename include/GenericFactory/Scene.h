@@ -0,0 +1,375 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#ifndef GENERICFACTORY_SCENE_H_
+#define GENERICFACTORY_SCENE_H_
+
+#if defined(WINDOWS) || defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <unordered_map>
+#include <vector>
+
+#include "GenericFactory/Diagnostics.h"
+#include "GenericFactory/GenericFactory_impl.h"
+#include "GenericFactory/HashedName.h"
+#include "GenericFactory/Property.h"
+#include "GenericFactory/Serialization.h"
+
+namespace genericfactory {
+/// A scene file holds many objects. Class and property names are stored
+/// once in tables, objects refer to them by index:
+///   "GFSC", version (uint32_t)
+///   number of class names, the names (size prefixed)
+///   number of property names, the names
+///   objects until the end of the file:
+///     class index, number of properties,
+///     per property: property index, size of the value, the value
+/// Values are encoded by BinaryCastHelper, numbers are raw bytes in the
+/// byte order of the machine that wrote the file.
+const char kSceneMagic[4] = {'G', 'F', 'S', 'C'};
+const std::uint32_t kSceneVersion = 1;
+
+/// Collects objects and writes them as a scene file.
+template<typename Base>
+class SceneWriter {
+ public:
+  /// Starts a object of class className. Add its properties with
+  /// addProperty.
+  void beginObject(std::string_view className) {
+    m_Objects.writeSize(intern(className, &m_ClassIndices, &m_ClassNames));
+    m_CountOffset = m_Objects.beginBlock();
+    m_Count = 0;
+  }
+  /// Adds a property to the current object, encoded while writing so
+  /// loading doesnt need to parse it.
+  template<typename T>
+  void addProperty(std::string_view name, const T& value) {
+    beginProperty(name);
+    const std::size_t block = m_Objects.beginBlock();
+    BinaryCastHelper<T>::write(value, &m_Objects);
+    m_Objects.endBlock(block);
+  }
+  /// Adds the class and all properties of obj (see
+  /// GenericFactory<Base>::serialize). Returns false and adds nothing if its
+  /// class isnt registered or it cant be read back.
+  bool add(const Base* const objPtr) {
+    m_Scratch.clear();
+    if (!GenericFactory<Base>::serialize(objPtr, &m_Scratch))
+      return false;
+    BinaryReader reader(m_Scratch.buffer());
+    std::string_view name;
+    std::uint32_t count = 0;
+    if (!reader.readString(&name) || !reader.readSize(&count))
+      return false;
+    // Check every property before the object is started.
+    BinaryReader check = reader;
+    for (std::uint32_t i = 0; i < count; ++i) {
+      std::string_view text;
+      if (!check.readString(&text) || !check.readString(&text))
+        return false;
+    }
+    beginObject(name);
+    for (std::uint32_t i = 0; i < count; ++i) {
+      std::string_view value;
+      reader.readString(&name);
+      reader.readString(&value);
+      beginProperty(name);
+      m_Objects.writeString(value);
+    }
+    return true;
+  }
+  /// Returns the whole file.
+  std::string finish() const {
+    BinaryWriter file;
+    file.write(kSceneMagic, sizeof(kSceneMagic));
+    file.writeSize(kSceneVersion);
+    for (const std::vector<std::string>* names :
+         {&m_ClassNames, &m_PropertyNames}) {
+      file.writeSize(static_cast<std::uint32_t>(names->size()));
+      for (const std::string& name : *names)
+        file.writeString(name);
+    }
+    file.write(m_Objects.buffer().data(), m_Objects.buffer().size());
+    return std::string(file.buffer());
+  }
+  /// Writes the file to path. Returns false if it cant be written.
+  bool save(const char* const path) const {
+    const std::string file = finish();
+    FILE* out = fopen(path, "wb");
+    if (!out) {
+      report(ErrorCode::kBadFile, path);
+      return false;
+    }
+    const bool written =
+        fwrite(file.data(), 1, file.size(), out) == file.size();
+    fclose(out);
+    if (!written)
+      report(ErrorCode::kBadFile, path);
+    return written;
+  }
+
+ private:
+  typedef std::unordered_map<std::string, std::uint32_t> Indices;
+  static std::uint32_t intern(
+        std::string_view name,
+        Indices* const indices,
+        std::vector<std::string>* const names) {
+    const auto inserted = indices->emplace(std::string(name),
+          static_cast<std::uint32_t>(names->size()));
+    if (inserted.second)
+      names->push_back(inserted.first->first);
+    return inserted.first->second;
+  }
+  void beginProperty(std::string_view name) {
+    m_Objects.writeSize(intern(name, &m_PropertyIndices, &m_PropertyNames));
+    m_Objects.patchSize(m_CountOffset, ++m_Count);
+  }
+  Indices m_ClassIndices;
+  std::vector<std::string> m_ClassNames;
+  Indices m_PropertyIndices;
+  std::vector<std::string> m_PropertyNames;
+  BinaryWriter m_Objects;
+  BinaryWriter m_Scratch;
+  /// Where the property count of the current object goes.
+  std::size_t m_CountOffset = 0;
+  std::uint32_t m_Count = 0;
+};
+
+/// A read only file in memory. Mapped where mmap is available, read
+/// otherwise.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() {
+    close();
+  }
+
+  /// Returns false if the file cant be opened.
+  bool open(const char* const path) {
+    close();
+#if defined(WINDOWS) || defined(_WIN32)
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+      return false;
+    m_Copy.assign(std::istreambuf_iterator<char>(in),
+                  std::istreambuf_iterator<char>());
+    m_Data = std::string_view(m_Copy);
+    return true;
+#else
+    const int file = ::open(path, O_RDONLY);
+    if (file < 0)
+      return false;
+    struct stat info;
+    if (fstat(file, &info) != 0) {
+      ::close(file);
+      return false;
+    }
+    m_Size = static_cast<std::size_t>(info.st_size);
+    if (m_Size) {
+      m_Memory = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+      if (m_Memory == MAP_FAILED) {
+        m_Memory = nullptr;
+        ::close(file);
+        return false;
+      }
+      // The loader reads front to back.
+      madvise(m_Memory, m_Size, MADV_SEQUENTIAL);
+    }
+    ::close(file);
+    m_Data = std::string_view(static_cast<const char*>(m_Memory), m_Size);
+    return true;
+#endif
+  }
+  void close() {
+#if defined(WINDOWS) || defined(_WIN32)
+    m_Copy.clear();
+#else
+    if (m_Memory)
+      munmap(m_Memory, m_Size);
+    m_Memory = nullptr;
+    m_Size = 0;
+#endif
+    m_Data = std::string_view();
+  }
+  std::string_view data() const {
+    return m_Data;
+  }
+
+ private:
+#if defined(WINDOWS) || defined(_WIN32)
+  std::string m_Copy;
+#else
+  void* m_Memory = nullptr;
+  std::size_t m_Size = 0;
+#endif
+  std::string_view m_Data;
+};
+
+/// Creates the objects of a scene file through GenericFactory<Base>.
+/// Every class and property name is looked up once per file, values are
+/// set from the bytes in the file.
+template<typename Base>
+class SceneLoader {
+ public:
+  /// Maps the file at path.
+  bool open(const char* const path) {
+    if (m_File.open(path))
+      return true;
+    report(ErrorCode::kBadFile, path);
+    return false;
+  }
+  /// Creates all objects and appends them to objPtrs (in file order).
+  /// Objects of unknown classes are skipped. Reads from data if given,
+  /// otherwise from the opened file. Returns the number of objects created.
+  std::size_t load(
+        std::vector<Base*>* const objPtrs,
+        std::string_view data = std::string_view()) {
+    BinaryReader reader(data.empty() ? m_File.data() : data);
+    std::vector<ClassEntry> classes;
+    std::vector<std::string_view> propNames;
+    if (!readHeader(&reader, &classes, &propNames)) {
+      report(ErrorCode::kBadFile, "scene");
+      return 0;
+    }
+    std::size_t created = 0;
+    while (!reader.atEnd()) {
+      std::uint32_t classIndex;
+      std::uint32_t count;
+      if (!reader.readSize(&classIndex) || classIndex >= classes.size()
+          || !reader.readSize(&count)) {
+        report(ErrorCode::kBadFile, "scene");
+        break;
+      }
+      ClassEntry& cls = classes[classIndex];
+      Base* obj = createOf(&cls);
+      bool good = true;
+      for (std::uint32_t i = 0; i < count && good; ++i) {
+        std::uint32_t propIndex;
+        std::string_view value;
+        good = reader.readSize(&propIndex) && propIndex < propNames.size()
+            && reader.readString(&value);
+        if (good && obj)
+          setOf(&cls, propNames, propIndex, obj, value);
+      }
+      if (!good) {
+        report(ErrorCode::kBadFile, "scene");
+        delete obj;
+        break;
+      }
+      if (obj) {
+        objPtrs->push_back(obj);
+        ++created;
+      }
+    }
+    return created;
+  }
+
+ private:
+  struct ClassEntry {
+    std::string_view name;
+    std::size_t hash;
+    /// 0: not looked up, 1: registered, 2: unknown.
+    int state;
+    /// By property index, resolved on first use.
+    std::vector<PropertyHandle<Base> > handles;
+    std::vector<bool> resolved;
+  };
+  static bool readHeader(
+        BinaryReader* const reader,
+        std::vector<ClassEntry>* const classes,
+        std::vector<std::string_view>* const propNames) {
+    std::string_view magic;
+    std::uint32_t version;
+    if (!reader->readBytes(sizeof(kSceneMagic), &magic)
+        || magic != std::string_view(kSceneMagic, sizeof(kSceneMagic))
+        || !reader->readSize(&version) || version != kSceneVersion)
+      return false;
+    std::uint32_t count;
+    if (!reader->readSize(&count))
+      return false;
+    for (std::uint32_t i = 0; i < count; ++i) {
+      std::string_view name;
+      if (!reader->readString(&name))
+        return false;
+      classes->push_back(ClassEntry{name, hashName(name), 0, {}, {}});
+    }
+    if (!reader->readSize(&count))
+      return false;
+    for (std::uint32_t i = 0; i < count; ++i) {
+      std::string_view name;
+      if (!reader->readString(&name))
+        return false;
+      propNames->push_back(name);
+    }
+    for (ClassEntry& cls : *classes) {
+      cls.handles.resize(propNames->size());
+      cls.resolved.resize(propNames->size());
+    }
+    return true;
+  }
+  /// The first object of a class is created by name (which checks the
+  /// name), the others by its hash.
+  static Base* createOf(ClassEntry* const cls) {
+    if (cls->state == 1)
+      return GenericFactory<Base>::create(HashedName(cls->hash));
+    if (cls->state == 2)
+      return nullptr;
+    Base* obj = GenericFactory<Base>::create(cls->name);
+    cls->state = obj ? 1 : 2;
+    return obj;
+  }
+  static void setOf(
+        ClassEntry* const cls,
+        const std::vector<std::string_view>& propNames,
+        std::uint32_t propIndex,
+        Base* const obj,
+        std::string_view value) {
+    PropertyHandle<Base>& handle = cls->handles[propIndex];
+    if (!cls->resolved[propIndex]) {
+      cls->resolved[propIndex] = true;
+      handle = GenericFactory<Base>::findProperty(propNames[propIndex], obj);
+      if (!handle)
+        report(ErrorCode::kUnknownProperty, propNames[propIndex]);
+    }
+    if (handle && !handle.read(obj, value))
+      report(ErrorCode::kBadValue, propNames[propIndex]);
+  }
+  MappedFile m_File;
+};
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_SCENE_H_
@@ -0,0 +1,200 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#ifndef GENERICFACTORY_SERIALIZATION_H_
+#define GENERICFACTORY_SERIALIZATION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+
+namespace genericfactory {
+/// Collects objects written by GenericFactory<Base>::serialize(obj, &writer).
+/// Every object is its class name, the number of properties and for every
+/// property its name and value. Names and values are prefixed with their
+/// size (uint32_t). Numbers are stored as raw bytes (in the byte order of
+/// the machine), so the buffer is meant to be read on the same platform.
+class BinaryWriter {
+ public:
+  void write(const void* const data, std::size_t size) {
+    m_Buffer.append(static_cast<const char*>(data), size);
+  }
+  void writeSize(std::uint32_t size) {
+    write(&size, sizeof(size));
+  }
+  /// Writes size and characters of text.
+  void writeString(std::string_view text) {
+    writeSize(static_cast<std::uint32_t>(text.size()));
+    write(text.data(), text.size());
+  }
+  /// Reserves a size to be filled in by endBlock() with the number of bytes
+  /// written in between.
+  std::size_t beginBlock() {
+    writeSize(0);
+    return m_Buffer.size();
+  }
+  void endBlock(std::size_t block) {
+    patchSize(block, static_cast<std::uint32_t>(m_Buffer.size() - block));
+  }
+  /// Overwrites the size written right before offset.
+  void patchSize(std::size_t offset, std::uint32_t size) {
+    std::memcpy(&m_Buffer[offset - sizeof(size)], &size, sizeof(size));
+  }
+  std::string_view buffer() const {
+    return m_Buffer;
+  }
+  /// Starts over, keeping the memory.
+  void clear() {
+    m_Buffer.clear();
+  }
+
+ private:
+  std::string m_Buffer;
+};
+
+/// Reads what a BinaryWriter wrote. Views point into the data, nothing is
+/// copied. Every read returns false if the data ends too early.
+class BinaryReader {
+ public:
+  BinaryReader(const char* const data, std::size_t size)
+    : m_Data(data),
+      m_End(data + size) { }
+  explicit BinaryReader(std::string_view buffer)
+    : BinaryReader(buffer.data(), buffer.size()) { }
+
+  bool readSize(std::uint32_t* const size) {
+    if (static_cast<std::size_t>(m_End - m_Data) < sizeof(*size))
+      return false;
+    std::memcpy(size, m_Data, sizeof(*size));
+    m_Data += sizeof(*size);
+    return true;
+  }
+  /// Reads size bytes.
+  bool readBytes(std::size_t size, std::string_view* const bytes) {
+    if (static_cast<std::size_t>(m_End - m_Data) < size)
+      return false;
+    *bytes = std::string_view(m_Data, size);
+    m_Data += size;
+    return true;
+  }
+  /// Reads a size and as many bytes.
+  bool readString(std::string_view* const text) {
+    std::uint32_t size;
+    return readSize(&size) && readBytes(size, text);
+  }
+  bool atEnd() const {
+    return m_Data == m_End;
+  }
+
+ private:
+  const char* m_Data;
+  const char* m_End;
+};
+
+/// Text form of the same (slower, values go through StringCastHelper):
+///   ClassName
+///   propertyName=value
+///   ...
+///   <empty line>
+/// Backslashes and newlines in values are escaped.
+class TextWriter {
+ public:
+  void writeClass(std::string_view name) {
+    m_Text.append(name.data(), name.size());
+    m_Text += '\n';
+  }
+  void writeProperty(std::string_view name, std::string_view value) {
+    m_Text.append(name.data(), name.size());
+    m_Text += '=';
+    for (char c : value) {
+      if (c == '\\')
+        m_Text += "\\\\";
+      else if (c == '\n')
+        m_Text += "\\n";
+      else
+        m_Text += c;
+    }
+    m_Text += '\n';
+  }
+  void endObject() {
+    m_Text += '\n';
+  }
+  const std::string& text() const {
+    return m_Text;
+  }
+  void clear() {
+    m_Text.clear();
+  }
+
+ private:
+  std::string m_Text;
+};
+
+/// Reads what a TextWriter wrote.
+class TextReader {
+ public:
+  explicit TextReader(std::string_view text) : m_Text(text) { }
+
+  /// Reads the class name of the next object.
+  bool readClass(std::string_view* const name) {
+    return readLine(name) && !name->empty();
+  }
+  /// Reads the next property of the object (unescaped to *value). Returns
+  /// false at the end of the object.
+  bool readProperty(std::string_view* const name, std::string* const value) {
+    std::string_view line;
+    if (!readLine(&line) || line.empty())
+      return false;
+    const std::size_t split = line.find('=');
+    *name = line.substr(0, split);
+    value->clear();
+    if (split == std::string_view::npos)
+      return true;
+    for (std::size_t i = split + 1; i < line.size(); ++i) {
+      if (line[i] == '\\' && i + 1 < line.size())
+        *value += line[++i] == 'n' ? '\n' : line[i];
+      else
+        *value += line[i];
+    }
+    return true;
+  }
+  bool atEnd() const {
+    return m_Text.empty();
+  }
+
+ private:
+  bool readLine(std::string_view* const line) {
+    if (m_Text.empty())
+      return false;
+    const std::size_t end = m_Text.find('\n');
+    *line = m_Text.substr(0, end);
+    m_Text.remove_prefix(end == std::string_view::npos ? m_Text.size()
+                                                       : end + 1);
+    return true;
+  }
+  std::string_view m_Text;
+};
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_SERIALIZATION_H_
@@ -0,0 +1,469 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#ifndef GENERICFACTORY_STATICFACTORY_H_
+#define GENERICFACTORY_STATICFACTORY_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>  // NOLINT(build/include_order)
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "GenericFactory/Diagnostics.h"
+#include "GenericFactory/FixedString.h"
+#include "GenericFactory/GenericFactory_decl.h"
+#include "GenericFactory/HashedName.h"
+#include "GenericFactory/Property.h"
+#ifndef DISABLELITERALSTRING
+#include "./LiteralStringList.h"
+#endif  // DISABLELITERALSTRING
+
+namespace genericfactory {
+/// A property known while compiling. Classes list theirs in
+///   static constexpr auto properties = std::make_tuple(
+///         staticProperty("name", &C::setName, &C::getName), ...);
+/// Subclasses see the properties of their bases. If they list their own too,
+/// the properties of bases that are listed in the StaticFactory are added,
+/// on a clash the most derived class wins.
+template<typename OwnerClass, typename Type>
+struct StaticProperty {
+  typedef Type ValueType;
+  std::string_view name;
+  void (OwnerClass::*setter)(ValueType value);
+  ValueType (OwnerClass::*getter)() const;
+};
+
+template<typename OwnerClass, typename ValueType>
+constexpr StaticProperty<OwnerClass, ValueType> staticProperty(
+      std::string_view name,
+      void (OwnerClass::*setPtr)(ValueType),
+      ValueType (OwnerClass::*getPtr)() const) {
+  return StaticProperty<OwnerClass, ValueType>{name, setPtr, getPtr};
+}
+
+// HELPER START
+/// Length and characters of a name while compiling. Names have to be
+/// constexpr (FixedString, literal_str_list or constexpr const char*).
+constexpr std::size_t staticNameSize(const char* const name) {
+  return std::string_view(name).size();
+}
+constexpr char staticNameChar(const char* const name, std::size_t i) {
+  return name[i];
+}
+template<std::size_t N>
+constexpr std::size_t staticNameSize(const FixedString<N>&) {
+  return N;
+}
+template<std::size_t N>
+constexpr char staticNameChar(const FixedString<N>& name, std::size_t i) {
+  return name[i];
+}
+#ifndef DISABLELITERALSTRING
+constexpr std::size_t staticNameSize(const literal_str_list& name) {
+  return name.size();
+}
+constexpr char staticNameChar(const literal_str_list& name, std::size_t i) {
+  return name[i];
+}
+#endif  // DISABLELITERALSTRING
+
+/// The name of C flattened into a array while compiling.
+template<typename C>
+struct StaticName {
+  static constexpr std::size_t size = staticNameSize(C::name);
+  static constexpr std::array<char, size + 1> flatten() {
+    std::array<char, size + 1> chars = {};
+    for (std::size_t i = 0; i < size; ++i)
+      chars[i] = staticNameChar(C::name, i);
+    return chars;
+  }
+  static constexpr std::array<char, size + 1> chars = flatten();
+  static constexpr std::string_view view() {
+    return std::string_view(chars.data(), size);
+  }
+};
+
+/// The properties C lists (an empty tuple if it has none).
+template<typename C, typename = int>
+struct StaticPropertiesOf {
+  static constexpr std::tuple<> get() {
+    return std::tuple<>();
+  }
+};
+template<typename C>
+struct StaticPropertiesOf<C, typename OkCase<decltype(C::properties)>::type> {
+  static constexpr const auto& get() {
+    return C::properties;
+  }
+};
+
+/// Seed and size (2^bits slots) of a perfect hash over the names.
+struct StaticHashParams {
+  std::uint64_t seed;
+  unsigned int bits;
+};
+
+constexpr std::size_t staticSlot(
+      std::size_t hash,
+      StaticHashParams params) {
+  return static_cast<std::size_t>(
+        ((static_cast<std::uint64_t>(hash) ^ params.seed)
+         * 0x9E3779B97F4A7C15u) >> (64 - params.bits));
+}
+
+/// Searches the smallest table (up to 16 times the number of names) and a
+/// seed that map all hashes to different slots. bits is 0 if there is none
+/// (two names have the same hash).
+template<std::size_t N>
+constexpr StaticHashParams findStaticHashParams(
+      const std::array<std::size_t, N>& hashes) {
+  unsigned int minBits = 1;
+  while ((std::size_t(1) << minBits) < N)
+    ++minBits;
+  for (unsigned int bits = minBits; bits <= minBits + 4; ++bits) {
+    for (std::uint64_t seed = 0; seed < 256; ++seed) {
+      const StaticHashParams params{seed, bits};
+      std::array<bool, (N < 2 ? 2 : N) * 32> taken = {};
+      bool perfect = true;
+      for (std::size_t i = 0; i < N && perfect; ++i) {
+        const std::size_t slot = staticSlot(hashes[i], params);
+        perfect = !taken[slot];
+        taken[slot] = true;
+      }
+      if (perfect)
+        return params;
+    }
+  }
+  return StaticHashParams{0, 0};
+}
+// HELPER END
+
+/// A factory for a closed set of Classes (all deriving from Base) that is
+/// built while compiling: a perfect hash table over their names, creation
+/// thunks and the properties they list. Nothing is registered, allocated or
+/// initialized at runtime. Use it like GenericFactory<Base>:
+///   typedef StaticFactory<A, B, D<B> > Factory;
+///   A* obj = Factory::create("B_ofD");
+///   Factory::setProperty("basic", obj, "value");
+/// Abstract classes can be listed for their properties, they arent created.
+/// Classes must not derive from Base virtually.
+template<typename Base, typename... Classes>
+class StaticFactory {
+ public:
+  /// Creates a object of class name or returns nullptr (and reports it).
+  static Base* create(std::string_view name) {
+    Base* obj = nullptr;
+    const ErrorCode error = tryCreate(name, &obj);
+    if (error != ErrorCode::kNone)
+      report(error, name);
+    return obj;
+  }
+  /// Same as create(name) but returns the error instead of reporting it.
+  static ErrorCode tryCreate(std::string_view name, Base** const objPtr) {
+    const std::size_t hash = hashName(name);
+    const Slot& slot = kTable[staticSlot(hash, kParams)];
+    if (slot.hash != hash || !slot.creatable || slot.name != name) {
+      *objPtr = nullptr;
+      return ErrorCode::kUnknownClass;
+    }
+    *objPtr = slot.create();
+    return ErrorCode::kNone;
+  }
+  /// Creates the class whose name hashes to Hash. Doesnt compile if it isnt
+  /// one of Classes, the call goes straight to its constructor.
+  template<std::size_t Hash>
+  static Base* create() {
+    constexpr const Slot& slot = kTable[staticSlot(Hash, kParams)];
+    static_assert(slot.hash == Hash && slot.creatable,
+        "No creatable class of this StaticFactory has this name");
+    return slot.create();
+  }
+  /// Same as above with a hash computed at runtime.
+  static Base* create(HashedName name) {
+    const Slot& slot = kTable[staticSlot(name.hash, kParams)];
+    if (slot.hash != name.hash || !slot.creatable) {
+      report(ErrorCode::kUnknownClass, std::string_view());
+      return nullptr;
+    }
+    return slot.create();
+  }
+  /// Returns true if name is one of the creatable Classes.
+  static constexpr bool contains(std::string_view name) {
+    const Slot& slot = kTable[staticSlot(hashName(name), kParams)];
+    return slot.creatable && slot.name == name;
+  }
+
+  /// Properties of the dynamic type of objPtr, see GenericFactory.
+  static void setProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const std::string& value) {
+    const ErrorCode error = trySetProperty(propName, objPtr, value);
+    if (error != ErrorCode::kNone)
+      report(error, propName);
+  }
+  static std::string getProperty(
+        std::string_view propName,
+        Base* const objPtr) {
+    std::string value;
+    const ErrorCode error = tryGetProperty(propName, objPtr, &value);
+    if (error == ErrorCode::kNone)
+      return value;
+    report(error, propName);
+    return "ERROR";
+  }
+  template<typename T>
+  static bool setProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const typename NonDeduced<T>::type& value) {
+    const ErrorCode error = trySetProperty<T>(propName, objPtr, value);
+    if (error == ErrorCode::kNone)
+      return true;
+    report(error, propName);
+    return false;
+  }
+  template<typename T>
+  static T getProperty(
+        std::string_view propName,
+        Base* const objPtr) {
+    T value = T();
+    const ErrorCode error = tryGetProperty<T>(propName, objPtr, &value);
+    if (error != ErrorCode::kNone)
+      report(error, propName);
+    return value;
+  }
+
+  /// Same as above but return the error instead of reporting it.
+  static ErrorCode trySetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const std::string& value) {
+    return visitProperty(propName, objPtr, [&value](auto* me, auto& prop) {
+      typedef typename std::decay<decltype(prop)>::type::ValueType Type;
+      Type parsed = Type();
+      if (!StringCastHelper<Type>::parse(value, &parsed))
+        return ErrorCode::kBadValue;
+      (me->*prop.setter)(std::move(parsed));
+      return ErrorCode::kNone;
+    });
+  }
+  static ErrorCode tryGetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        std::string* const value) {
+    return visitProperty(propName, objPtr, [value](auto* me, auto& prop) {
+      typedef typename std::decay<decltype(prop)>::type::ValueType Type;
+      *value = StringCastHelper<Type>::toString((me->*prop.getter)());
+      return ErrorCode::kNone;
+    });
+  }
+  template<typename T>
+  static ErrorCode trySetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        const typename NonDeduced<T>::type& value) {
+    return visitProperty(propName, objPtr, [&value](auto* me, auto& prop) {
+      typedef typename std::decay<decltype(prop)>::type::ValueType Type;
+      if constexpr (std::is_same<Type, T>::value) {
+        (me->*prop.setter)(value);
+        return ErrorCode::kNone;
+      } else {
+        return ErrorCode::kWrongType;
+      }
+    });
+  }
+  template<typename T>
+  static ErrorCode tryGetProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        T* const value) {
+    return visitProperty(propName, objPtr, [value](auto* me, auto& prop) {
+      typedef typename std::decay<decltype(prop)>::type::ValueType Type;
+      if constexpr (std::is_same<Type, T>::value) {
+        *value = (me->*prop.getter)();
+        return ErrorCode::kNone;
+      } else {
+        return ErrorCode::kWrongType;
+      }
+    });
+  }
+
+  /// Number of Classes.
+  static constexpr std::size_t size() {
+    return sizeof...(Classes);
+  }
+
+ private:
+  /// We dont want anyone to create this.
+  StaticFactory();
+
+  struct Slot {
+    std::size_t hash;
+    std::string_view name;
+    /// nullptr for empty slots and classes that cant be created.
+    Base* (*create)();
+    /// Same as create != nullptr, but usable in constant expressions (the
+    /// address of a function isnt with -fsanitize=undefined).
+    bool creatable;
+  };
+
+  template<typename C>
+  static Base* construct() {
+    return new C();
+  }
+  template<typename C>
+  static constexpr bool isCreatable() {
+    return !std::is_abstract<C>::value
+        && std::is_default_constructible<C>::value;
+  }
+  template<typename C>
+  static constexpr Base* (*creatorOf())() {
+    static_assert(std::is_base_of<Base, C>::value,
+        "C dosn`t have base Base\n");
+    if constexpr (isCreatable<C>())
+      return &construct<C>;
+    else
+      return nullptr;
+  }
+
+  static constexpr std::array<std::size_t, sizeof...(Classes)> kHashes = {{
+    hashName(StaticName<Classes>::view())...
+  }};
+  static constexpr StaticHashParams kParams = findStaticHashParams(kHashes);
+  static_assert(kParams.bits != 0,
+      "Two classes of this StaticFactory have the same name (hash)");
+
+  static constexpr std::array<Slot, std::size_t(1) << kParams.bits>
+  buildTable() {
+    std::array<Slot, std::size_t(1) << kParams.bits> table = {};
+    const Slot slots[] = {
+      Slot{hashName(StaticName<Classes>::view()),
+           StaticName<Classes>::view(),
+           creatorOf<Classes>(),
+           isCreatable<Classes>()}...
+    };
+    // Empty slots arent creatable, lookups check it before the name.
+    for (const Slot& slot : slots)
+      table[staticSlot(slot.hash, kParams)] = slot;
+    return table;
+  }
+  static constexpr std::array<Slot, std::size_t(1) << kParams.bits> kTable =
+      buildTable();
+
+  /// Calls visit(me, prop) with the object cast to its dynamic type (one of
+  /// Classes) and the property called propName.
+  template<typename Visitor>
+  static ErrorCode visitProperty(
+        std::string_view propName,
+        Base* const objPtr,
+        Visitor visit) {
+    ErrorCode error = ErrorCode::kUnknownProperty;
+    const std::type_info& type = typeid(*objPtr);
+    static_cast<void>(((type == typeid(Classes)
+        && visitIn<Classes>(propName, objPtr, &visit, &error)) || ...));
+    return error;
+  }
+  template<typename C, typename Visitor>
+  static bool visitIn(
+        std::string_view propName,
+        Base* const objPtr,
+        Visitor* const visit,
+        ErrorCode* const error) {
+    C* const me = static_cast<C*>(objPtr);
+    int deepest = -1;
+    static_cast<void>(((deepest = std::max(deepest,
+        depthWith<C, Classes>(propName))), ...));
+    static_cast<void>((visitFrom<C, Classes>(
+        propName, me, deepest, visit, error) || ...));
+    return true;
+  }
+
+  /// True if X lists properties itself and doesnt only inherit them from one
+  /// of Classes. Not constexpr, addresses arent with -fsanitize=undefined.
+  template<typename X>
+  static bool ownsProperties() {
+    if constexpr (std::is_same<decltype(StaticPropertiesOf<X>::get()),
+                               std::tuple<> >::value)
+      return false;
+    else
+      return (!inheritsProperties<X, Classes>() && ...);
+  }
+  template<typename X, typename Y>
+  static bool inheritsProperties() {
+    if constexpr (std::is_same<X, Y>::value || !std::is_base_of<Y, X>::value
+                  || std::is_same<decltype(StaticPropertiesOf<Y>::get()),
+                                  std::tuple<> >::value)
+      return false;
+    else
+      return static_cast<const void*>(&X::properties)
+          == static_cast<const void*>(&Y::properties);
+  }
+  /// Number of Classes X derives from.
+  template<typename X>
+  static constexpr int depthOf() {
+    return ((std::is_base_of<Classes, X>::value
+             && !std::is_same<Classes, X>::value) + ... + 0);
+  }
+  /// The depth of X if C gets the properties of X and one is called
+  /// propName, -1 otherwise.
+  template<typename C, typename X>
+  static int depthWith(std::string_view propName) {
+    if constexpr (std::is_base_of<X, C>::value) {
+      if (!ownsProperties<X>())
+        return -1;
+      return std::apply([propName](const auto&... props) {
+        return ((props.name == propName) || ...);
+      }, StaticPropertiesOf<X>::get()) ? depthOf<X>() : -1;
+    } else {
+      return -1;
+    }
+  }
+  /// Visits the property propName of X if it is as deep as deepest.
+  template<typename C, typename X, typename Visitor>
+  static bool visitFrom(
+        std::string_view propName,
+        C* const me,
+        const int deepest,
+        Visitor* const visit,
+        ErrorCode* const error) {
+    if constexpr (std::is_base_of<X, C>::value) {
+      if (depthOf<X>() != deepest || !ownsProperties<X>())
+        return false;
+      return std::apply([&](const auto&... props) {
+        return ((props.name == propName
+            && (*error = (*visit)(me, props), true)) || ...);
+      }, StaticPropertiesOf<X>::get());
+    } else {
+      return false;
+    }
+  }
+};
+}  // namespace genericfactory
+#endif  // GENERICFACTORY_STATICFACTORY_H_
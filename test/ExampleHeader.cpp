@@ -48,6 +48,47 @@ void A::registerProperties() {
         "test",
         &D<B>::setTest,
         &D<B>::getTest);
+  // Same name on an unrelated class. Each class has its own table.
+  genericfactory::GenericFactory<A>::registerProperty(
+        "test",
+        &D<A>::setTest,
+        &D<A>::getTest);
+}
+
+void Counter::registerProperties() {
+  static bool m_lock(true);
+  if (!m_lock)
+    return;
+  m_lock = false;
+  genericfactory::GenericFactory<A>::registerProperty(
+        "count",
+        &Counter::setCount,
+        &Counter::getCount);
+  genericfactory::GenericFactory<A>::registerProperty(
+        "label",
+        &Counter::setLabel,
+        &Counter::getLabel);
+  genericfactory::GenericFactory<A>::registerProperty(
+        "tag",
+        &Counter::setTag,
+        &Counter::getTag);
+  genericfactory::GenericFactory<A>::registerProperty("hits", &Counter::hits);
+}
+
+void Lazy::registerProperties() {
+  ++registered;
+  genericfactory::GenericFactory<A>::registerProperty(
+        "value",
+        &Lazy::setValue,
+        &Lazy::getValue);
+}
+
+void Mid::registerProperties() {
+  genericfactory::GenericFactory<A>::registerProperty("x", &Mid::m);
+}
+
+void Leaf::registerProperties() {
+  genericfactory::GenericFactory<A>::registerProperty("x", &Leaf::l);
 }
 
 namespace genericfactory {
@@ -58,31 +99,12 @@ char GenericFactory<A>::registerAllForBase() {
   GenericFactory<A>::registerClass<D<B> >();
   GenericFactory<A>::registerClass<D<A> >();
   GenericFactory<A>::registerClass<D<D<A> > >();
+  GenericFactory<A>::registerClass<Counter>();
+  GenericFactory<A>::registerClass<E>();
+  GenericFactory<A>::registerClassLazy<Lazy>();
+  // Subclass first on purpose.
+  GenericFactory<A>::registerClass<Leaf>();
+  GenericFactory<A>::registerClass<Mid>();
   return 'y';
 }
-
-// Implement string cast helpers here.
-template<>
-std::string StringCastHelper<float>::toString(
-      const float&) {
-  return "";
-}
-
-template<>
-float StringCastHelper<float>::fromString(
-      const std::string&) {
-  return 0.0f;
-}
-template<>
-std::string StringCastHelper<std::string>::toString(
-      const std::string& value) {
-  return value;
-}
-
-template<>
-std::string StringCastHelper<std::string>::fromString(
-      const std::string& value) {
-  return value;
-}
 }  // namespace genericfactory
-// String Helper Definitions.
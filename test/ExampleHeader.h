@@ -38,19 +38,7 @@ namespace genericfactory {
 template<>
 char GenericFactory<A>::registerAllForBase();
 
-// Define StringCastHelper specializations here.
-template<>
-std::string StringCastHelper<float>::toString(
-      const float&);
-template<>
-float StringCastHelper<float>::fromString(
-      const std::string&);
-template<>
-std::string StringCastHelper<std::string>::toString(
-      const std::string& value);
-
-template<>
-std::string StringCastHelper<std::string>::fromString(
-      const std::string& value);
+// Define StringCastHelper specializations here. Numbers, bool, enums and
+// std::string are converted without one.
 }  // namespace genericfactory
 #endif  // EXAMPLEHEADER_H_
@@ -22,12 +22,30 @@
 // IN THE SOFTWARE.
 
 #include <GenericFactory/GenericFactory_impl.h>
+#include <GenericFactory/Parallel.h>
+#include <GenericFactory/Scene.h>
+#include <GenericFactory/StaticFactory.h>
 
+#include <cstdint>
+#include <cstdio>
+#include <new>
 #include <string>
+#include <typeinfo>
+#include <vector>
 
+#include "./StressTest.h"
 #include "./TestClasses.h"
 
+namespace {
+std::string reportedSubject;
+void recordSink(genericfactory::ErrorCode, std::string_view subject) {
+  reportedSubject.assign(subject.data(), subject.size());
+}
+}  // namespace
+
 int main(int, char**) {
+  // The factory is silent unless a sink is installed.
+  genericfactory::setDiagnosticSink(genericfactory::stderrSink);
   A* obj = genericfactory::GenericFactory<A>::create("B_ofD");
   if (obj) {
     genericfactory::GenericFactory<A>::setProperty("basic", obj, "test");
@@ -35,6 +53,10 @@ int main(int, char**) {
     printf("Result: %s\n",
            genericfactory::GenericFactory<A>::getProperty("basic",
            obj).c_str());
+    // Typed access, no strings involved.
+    genericfactory::GenericFactory<A>::setProperty<float>("test", obj, 1.5f);
+    printf("Typed result: %f\n",
+           genericfactory::GenericFactory<A>::getProperty<float>("test", obj));
   } else {
     printf("WTF\n");
   }
@@ -48,5 +70,348 @@ int main(int, char**) {
            obj).c_str());
   }
   delete obj;
+  // Resolve a property once and use it on many objects of the same type.
+  A* objs[3] = {
+    genericfactory::GenericFactory<A>::create("B"),
+    genericfactory::GenericFactory<A>::create("B"),
+    genericfactory::GenericFactory<A>::create("B")
+  };
+  genericfactory::PropertyHandle<A> basic =
+      genericfactory::GenericFactory<A>::findProperty("basic", objs[0]);
+  for (A* o : objs)
+    basic.set(o, "handle");
+  // Or set the same values on all of them at once.
+  genericfactory::GenericFactory<A>::setProperties(objs, 3, {{"basic", "all"}});
+  for (A* o : objs)
+    delete o;
+  // The hash of the name is computed while compiling.
+  obj = genericfactory::GenericFactory<A>::create<D<D<A> >::name.hash()>();
+  if (obj)
+    obj->printMe();
+  delete obj;
+  obj = genericfactory::GenericFactory<A>::create("E");
+  if (obj)
+    obj->printMe();
+  delete obj;
+  // Objects can live in a arena or pool instead of the heap.
+  genericfactory::MonotonicArena arena;
+  genericfactory::ObjectPool pool;
+  obj = genericfactory::GenericFactory<A>::create("A_ofD", &arena);
+  if (obj)
+    obj->printMe();
+  obj = genericfactory::GenericFactory<A>::create("B", &pool);
+  if (obj) {
+    obj->printMe();
+    genericfactory::GenericFactory<A>::release(obj, &pool);
+  }
+  // Many objects of one class in one block.
+  A* many[4];
+  if (genericfactory::GenericFactory<A>::createMany("B", 4, many) != 4) {
+    printf("createMany failed\n");
+    return 1;
+  }
+  genericfactory::GenericFactory<A>::setProperties(many, 4,
+                                                   {{"basic", "many"}});
+  genericfactory::GenericFactory<A>::destroyMany(many, 4);
+  if (genericfactory::GenericFactory<A>::createMany("A_ofD", 4, many, &arena)
+        != 4) {
+    printf("createMany in arena failed\n");
+    return 1;
+  }
+  arena.reset();
+  // Too many objects for memory, or a constructor throwing, leave nothing
+  // behind.
+  genericfactory::GenericFactory<A>::registerClass<Fragile>();
+  bool tooMany = false;
+  try {
+    genericfactory::GenericFactory<A>::createMany("Fragile", SIZE_MAX / 2,
+                                                  many);
+  } catch (const std::bad_array_new_length&) {
+    tooMany = true;
+  }
+  bool thrown = false;
+  Fragile::built = 2;
+  try {
+    genericfactory::GenericFactory<A>::createMany("Fragile", 4, many);
+  } catch (int) {
+    thrown = true;
+  }
+  if (!tooMany || !thrown || Fragile::living) {
+    printf("createMany left %d objects behind\n", Fragile::living);
+    return 1;
+  }
+  // Misses can be handled without going through the sink.
+  if (genericfactory::GenericFactory<A>::tryCreate("NotThere", &obj)
+        != genericfactory::ErrorCode::kUnknownClass || obj) {
+    printf("tryCreate found a class that isnt registered\n");
+    return 1;
+  }
+  // Abstract classes are only reported when they are created.
+  if (genericfactory::GenericFactory<A>::tryCreate("A", &obj)
+        != genericfactory::ErrorCode::kNotConstructible || obj) {
+    printf("tryCreate created a abstract class\n");
+    return 1;
+  }
+  // A closed set of classes, looked up without any registration.
+  typedef genericfactory::StaticFactory<A, B, E, D<A>, D<B> > Static;
+  obj = Static::create("B_ofD");
+  if (!obj || Static::create("Counter")) {
+    printf("StaticFactory created the wrong classes\n");
+    return 1;
+  }
+  Static::setProperty("basic", obj, "static");
+  printf("Static result: %s\n", Static::getProperty("basic", obj).c_str());
+  delete obj;
+  obj = Static::create<E::name.hash()>();
+  obj->printMe();
+  // E lists its own properties and still has the ones of B.
+  Static::setProperty("level", obj, "3");
+  if (Static::getProperty<int>("level", obj) != 3
+      || Static::getProperty("basic", obj) != "Get Called"
+      || Static::trySetProperty("level", obj, "x")
+         != genericfactory::ErrorCode::kBadValue) {
+    printf("StaticFactory lost the properties of a base\n");
+    return 1;
+  }
+  delete obj;
+  // Numbers round-trip exactly through the built in StringCastHelper.
+  obj = genericfactory::GenericFactory<A>::create("Counter");
+  genericfactory::GenericFactory<A>::setProperty("count", obj, "0.1");
+  if (genericfactory::GenericFactory<A>::getProperty("count", obj) != "0.1"
+      || genericfactory::StringCastHelper<double>::fromString(
+            genericfactory::StringCastHelper<double>::toString(0.1 + 0.2))
+         != 0.1 + 0.2) {
+    printf("StringCastHelper doesnt round-trip\n");
+    return 1;
+  }
+  // Interned names, looked up once.
+  const genericfactory::PropertyId countId =
+      genericfactory::GenericFactory<A>::propertyId("count");
+  delete obj;
+  obj = genericfactory::GenericFactory<A>::create(
+        genericfactory::GenericFactory<A>::classId("Counter"));
+  if (!obj || !countId
+      || genericfactory::GenericFactory<A>::classId("NotRegistered")
+      || genericfactory::GenericFactory<A>::propertyId("NotRegistered")
+      || !genericfactory::GenericFactory<A>::setProperty<float>(
+            countId, obj, 1.5f)
+      || genericfactory::GenericFactory<A>::getProperty(countId, obj)
+         != "1.5") {
+    printf("Interned names dont work\n");
+    return 1;
+  }
+  // Data members are loaded and stored directly.
+  genericfactory::GenericFactory<A>::setProperty("hits", obj, "3");
+  A* other = genericfactory::GenericFactory<A>::create("Counter");
+  const genericfactory::PropertyHandle<A> hits =
+      genericfactory::GenericFactory<A>::findProperty("hits", obj);
+  if (!hits.isField() || !hits.copy(obj, other)
+      || !hits.setValue<int>(obj, hits.getValue<int>(other) + 1)
+      || static_cast<Counter*>(obj)->hits != 4
+      || genericfactory::GenericFactory<A>::getProperty("hits", other)
+         != "3") {
+    printf("Data member properties dont work\n");
+    return 1;
+  }
+  // Bad values leave the object as it is.
+  if (genericfactory::GenericFactory<A>::trySetProperty("hits", obj, "abc")
+        != genericfactory::ErrorCode::kBadValue
+      || genericfactory::GenericFactory<A>::trySetProperty("count", obj, "x")
+         != genericfactory::ErrorCode::kBadValue
+      || static_cast<Counter*>(obj)->hits != 4
+      || genericfactory::GenericFactory<A>::getProperty<float>("count", obj)
+         != 1.5f) {
+    printf("A bad value was set\n");
+    return 1;
+  }
+  A* counters[] = {obj, other};
+  genericfactory::setDiagnosticSink(nullptr);
+  if (genericfactory::GenericFactory<A>::setProperties(counters, 2,
+                                                       {{"hits", "abc"}})
+      || static_cast<Counter*>(obj)->hits != 4
+      || static_cast<Counter*>(other)->hits != 3) {
+    printf("setProperties set a bad value\n");
+    return 1;
+  }
+  // Reports name the property, not the value.
+  genericfactory::setDiagnosticSink(recordSink);
+  genericfactory::GenericFactory<A>::setProperty(countId, obj, "abc");
+  if (reportedSubject != "count") {
+    printf("A bad value was reported as %s\n", reportedSubject.c_str());
+    return 1;
+  }
+  genericfactory::setDiagnosticSink(genericfactory::stderrSink);
+  delete other;
+  // Setters taking references, getters returning them.
+  genericfactory::GenericFactory<A>::setProperty("label", obj, "by ref");
+  genericfactory::GenericFactory<A>::setProperty<std::string>("tag", obj,
+                                                              "moved");
+  if (genericfactory::GenericFactory<A>::getProperty("label", obj) != "by ref"
+      || genericfactory::GenericFactory<A>::getProperty<std::string>("tag", obj)
+         != "moved") {
+    printf("Reference properties dont work\n");
+    return 1;
+  }
+  // Copies of a configured object, no setter is called again.
+  A* preset = genericfactory::GenericFactory<A>::clone(obj);
+  genericfactory::GenericFactory<A>::registerPreset("Labeled", preset);
+  A* copy = genericfactory::GenericFactory<A>::create("Labeled");
+  if (!copy || typeid(*copy) != typeid(Counter)
+      || genericfactory::GenericFactory<A>::getProperty("label", copy)
+         != "by ref"
+      || genericfactory::GenericFactory<A>::getProperty<float>("count", copy)
+         != genericfactory::GenericFactory<A>::getProperty<float>(
+               "count", obj)) {
+    printf("Presets dont work\n");
+    return 1;
+  }
+  delete copy;
+  // Whole objects round-trip through create and the setters.
+  genericfactory::GenericFactory<A>::setProperty<float>("count", obj, 2.5f);
+  genericfactory::BinaryWriter writer;
+  genericfactory::TextWriter textWriter;
+  genericfactory::GenericFactory<A>::serialize(obj, &writer);
+  genericfactory::GenericFactory<A>::serialize(obj, &textWriter);
+  delete obj;
+  genericfactory::BinaryReader reader(writer.buffer());
+  genericfactory::TextReader textReader(textWriter.text());
+  A* copies[2] = {
+    genericfactory::GenericFactory<A>::deserialize(&reader),
+    genericfactory::GenericFactory<A>::deserialize(&textReader)
+  };
+  for (A* copy : copies) {
+    if (!copy
+        || genericfactory::GenericFactory<A>::getProperty<float>("count", copy)
+           != 2.5f
+        || genericfactory::GenericFactory<A>::getProperty<int>("hits", copy)
+           != 4) {
+      printf("Serialized object didnt round-trip\n");
+      return 1;
+    }
+    delete copy;
+  }
+  // A scene keeps each name once, the values are set from its bytes.
+  genericfactory::SceneWriter<A> scene;
+  for (int i = 0; i < 3; ++i) {
+    scene.beginObject("Counter");
+    scene.addProperty<float>("count", i + 0.5f);
+  }
+  scene.beginObject("NotRegistered");
+  const std::string sceneFile = scene.finish();
+  std::vector<A*> loaded;
+  genericfactory::SceneLoader<A> loader;
+  if (loader.load(&loaded, sceneFile) != 3
+      || genericfactory::GenericFactory<A>::getProperty<float>(
+            "count", loaded[2]) != 2.5f) {
+    printf("Scene didnt load\n");
+    return 1;
+  }
+  for (A* copy : loaded)
+    delete copy;
+  // The property of the most derived class wins.
+  obj = genericfactory::GenericFactory<A>::create("Leaf");
+  genericfactory::GenericFactory<A>::setProperty("x", obj, "5");
+  if (static_cast<Leaf*>(obj)->l != 5 || static_cast<Leaf*>(obj)->m != 0) {
+    printf("A base class property hides the one of the subclass\n");
+    return 1;
+  }
+  delete obj;
+  // Lazily registered classes register their properties on first use.
+  if (Lazy::registered) {
+    printf("Lazy class registered its properties too early\n");
+    return 1;
+  }
+  const std::vector<genericfactory::ObjectSpec> lazySpecs(
+        64, {"Lazy", {{"value", "7"}}});
+  for (A* lazy : genericfactory::createParallel<A>(lazySpecs, 4)) {
+    if (!lazy
+        || genericfactory::GenericFactory<A>::getProperty<int>("value", lazy)
+           != 7) {
+      printf("Lazy class has no properties\n");
+      return 1;
+    }
+    delete lazy;
+  }
+  if (Lazy::registered != 1) {
+    printf("Lazy class registered its properties %d times\n",
+           Lazy::registered);
+    return 1;
+  }
+  // Parallel creation keeps the order of the input.
+  std::vector<genericfactory::ObjectSpec> specs(1000);
+  for (std::size_t i = 0; i < specs.size(); ++i) {
+    specs[i].className = i % 100 ? "Counter" : "NotRegistered";
+    specs[i].properties.emplace_back("count", std::to_string(i));
+  }
+  const std::vector<A*> created =
+      genericfactory::createParallel<A>(specs, 4);
+  for (std::size_t i = 0; i < created.size(); ++i) {
+    if ((i % 100 == 0) != !created[i] || (created[i]
+        && genericfactory::GenericFactory<A>::getProperty<float>(
+              "count", created[i]) != i)) {
+      printf("createParallel created the wrong objects\n");
+      return 1;
+    }
+    delete created[i];
+  }
+  if (!stressRegistry(8, 10000)) {
+    printf("Stress test failed\n");
+    return 1;
+  }
+  if (!stressGrowth(1000)) {
+    printf("Registering while in use left too much behind\n");
+    return 1;
+  }
+  if (!stressLazy(8)) {
+    printf("A lazily registered class was missed\n");
+    return 1;
+  }
+  // Frozen registries are read only, lookups go through the flat index.
+  const genericfactory::RegistryMemory memory =
+      genericfactory::GenericFactory<A>::freeze();
+  printf("Frozen: %zu bytes, %zu before\n", memory.after, memory.before);
+  genericfactory::GenericFactory<A>::registerClass<D<E> >();
+  obj = genericfactory::GenericFactory<A>::create("B_ofD");
+  if (!obj || genericfactory::GenericFactory<A>::create("E_ofD")
+      || genericfactory::GenericFactory<A>::getProperty("basic", obj)
+         == "ERROR") {
+    printf("Frozen registry doesnt work\n");
+    return 1;
+  }
+  delete obj;
+  obj = genericfactory::GenericFactory<A>::create("Labeled");
+  if (!obj
+      || genericfactory::GenericFactory<A>::getProperty("label", obj)
+         != "by ref") {
+    printf("Frozen preset doesnt work\n");
+    return 1;
+  }
+  delete obj;
+  // Label values are escaped, histograms end with +Inf, _sum and _count.
+  genericfactory::FactoryStats stats;
+  stats.creations["say \"hi\"\\\n"] = 1;
+  stats.setLatency[3] = 2;
+  stats.setLatencySum = 20;
+  FILE* dumped = tmpfile();
+  stats.dump(dumped);
+  rewind(dumped);
+  std::string text;
+  for (int c = fgetc(dumped); c != EOF; c = fgetc(dumped))
+    text += static_cast<char>(c);
+  fclose(dumped);
+  for (const char* line : {
+        "genericfactory_creations{class=\"say \\\"hi\\\"\\\\\\n\"} 1\n",
+        "# TYPE genericfactory_latency_ns histogram\n",
+        "genericfactory_latency_ns_bucket{operation=\"set\",le=\"+Inf\"} 2\n",
+        "genericfactory_latency_ns_sum{operation=\"set\"} 20\n",
+        "genericfactory_latency_ns_count{operation=\"get\"} 0\n"}) {
+    if (text.find(line) == std::string::npos) {
+      printf("Stats dump misses %s", line);
+      return 1;
+    }
+  }
+#ifdef ENABLEINSTRUMENTATION
+  genericfactory::GenericFactory<A>::stats().dump(stdout);
+#endif  // ENABLEINSTRUMENTATION
   return 0;
 }
@@ -0,0 +1,221 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 CantTouchDis <bauschp@informatik.uni-freiburg.de>
+// Copyright (c) 2014 brio1009 <christoph1009@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#include "./StressTest.h"
+
+#include <GenericFactory/GenericFactory_impl.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "./TestClasses.h"
+
+using genericfactory::GenericFactory;
+
+namespace {
+// Base of the registry used by stressGrowth().
+struct Grown {
+ public:
+  virtual ~Grown() { }
+};
+// Gets its property registered again and again.
+struct Churned : public Grown {
+ public:
+  static constexpr genericfactory::FixedString name = "Churned";
+  static void registerProperties() {
+    GenericFactory<Grown>::registerProperty(
+          "value", &Churned::setValue, &Churned::getValue);
+  }
+  void setValue(int value) {
+    m_Value = value;
+  }
+  int getValue() const { return m_Value; }
+
+ private:
+  int m_Value = 0;
+};
+// Unrelated to Churned, its table is big and shouldnt be resolved again.
+struct Bystander : public Grown {
+ public:
+  static constexpr genericfactory::FixedString name = "Bystander";
+  static void registerProperties() {
+    for (int i = 0; i < 64; ++i) {
+      GenericFactory<Grown>::registerProperty("b" + std::to_string(i),
+            &Bystander::setValue, &Bystander::getValue);
+    }
+  }
+  void setValue(int value) {
+    m_Value = value;
+  }
+  int getValue() const { return m_Value; }
+
+ private:
+  int m_Value = 0;
+};
+// Base of the registry used by stressLazy().
+struct Raced {
+ public:
+  virtual ~Raced() { }
+};
+// Registered lazily while objects of LateLeaf are looked up.
+struct LateBase : public Raced {
+ public:
+  static constexpr genericfactory::FixedString name = "LateBase";
+  static void registerProperties() {
+    GenericFactory<Raced>::registerProperty("late", &LateBase::late);
+  }
+
+  int late = 0;
+};
+struct LateLeaf : public LateBase {
+ public:
+  static constexpr genericfactory::FixedString name = "LateLeaf";
+  static void registerProperties() {
+    GenericFactory<Raced>::registerProperty("own", &LateLeaf::own);
+  }
+
+  int own = 0;
+};
+}  // namespace
+
+namespace genericfactory {
+// Filled by stressGrowth().
+template<>
+char GenericFactory<Grown>::registerAllForBase() {
+  return 'y';
+}
+// Filled by stressLazy().
+template<>
+char GenericFactory<Raced>::registerAllForBase() {
+  return 'y';
+}
+}  // namespace genericfactory
+
+namespace {
+// Registers D<T>, D<D<T> >, ... (N classes).
+template<typename T, int N>
+struct RegisterNested {
+  static void registerAll() {
+    GenericFactory<A>::registerClass<T>();
+    RegisterNested<D<T>, N - 1>::registerAll();
+  }
+};
+template<typename T>
+struct RegisterNested<T, 0> {
+  static void registerAll() { }
+};
+}  // namespace
+
+bool stressRegistry(int readerCount, int iterations) {
+  std::atomic<bool> failed(false);
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < readerCount; ++r) {
+    readers.emplace_back([&failed, &done, iterations] {
+      for (int i = 0; i < iterations || !done; ++i) {
+        A* obj = GenericFactory<A>::create("Counter");
+        if (!obj) {
+          failed = true;
+          return;
+        }
+        const float value = static_cast<float>(i);
+        GenericFactory<A>::setProperty<float>("count", obj, value);
+        if (GenericFactory<A>::getProperty<float>("count", obj) != value)
+          failed = true;
+        delete obj;
+      }
+    });
+  }
+  // Late registrations while the readers are busy.
+  RegisterNested<D<D<B> >, 8>::registerAll();
+  for (int i = 0; i < 100; ++i) {
+    GenericFactory<A>::registerProperty(
+          "late" + std::to_string(i),
+          &Counter::setCount,
+          &Counter::getCount);
+  }
+  done = true;
+  for (std::thread& reader : readers)
+    reader.join();
+  A* late = GenericFactory<A>::create("B_ofD_ofD_ofD_ofD");
+  const bool created = late != nullptr;
+  delete late;
+  return !failed && created;
+}
+
+bool stressGrowth(int registrations) {
+  GenericFactory<Grown>::registerClass<Churned>();
+  GenericFactory<Grown>::registerClass<Bystander>();
+  Grown* churned = GenericFactory<Grown>::create("Churned");
+  Grown* bystander = GenericFactory<Grown>::create("Bystander");
+  bool failed = false;
+  for (int i = 0; i < registrations; ++i) {
+    Churned::registerProperties();
+    GenericFactory<Grown>::setProperty<int>("value", churned, i);
+    GenericFactory<Grown>::setProperty<int>("b0", bystander, i);
+    failed |= GenericFactory<Grown>::getProperty<int>("value", churned) != i
+        || GenericFactory<Grown>::getProperty<int>("b0", bystander) != i;
+  }
+  delete churned;
+  delete bystander;
+  // A table of Churned is about 2.5 kB (mostly the properties by id), one
+  // of Bystander about 9 kB. freeze() frees what was left behind.
+  const genericfactory::RegistryMemory memory =
+      GenericFactory<Grown>::freeze();
+  const std::size_t leftBehind = memory.before - memory.after;
+  if (leftBehind > static_cast<std::size_t>(registrations) * 4096) {
+    printf("%zu bytes left behind by %d registrations\n", leftBehind,
+        registrations);
+    failed = true;
+  }
+  return !failed;
+}
+
+bool stressLazy(int readerCount) {
+  GenericFactory<Raced>::registerClass<LateLeaf>();
+  std::atomic<bool> failed(false);
+  std::atomic<bool> registered(false);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < readerCount; ++r) {
+    readers.emplace_back([&failed, &registered] {
+      // Once registerClassLazy() returned, every lookup has to see it.
+      for (bool seen = false; !seen;) {
+        seen = registered;
+        Raced* obj = GenericFactory<Raced>::create("LateLeaf");
+        if (seen && !GenericFactory<Raced>::findProperty("late", obj))
+          failed = true;
+        delete obj;
+      }
+    });
+  }
+  GenericFactory<Raced>::registerClassLazy<LateBase>();
+  registered = true;
+  for (std::thread& reader : readers)
+    reader.join();
+  return !failed;
+}
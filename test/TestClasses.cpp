@@ -23,6 +23,25 @@
 
 #include "./TestClasses.h"
 
-constexpr literal_str_list A::name;
-constexpr literal_str_list B::name;
-constexpr literal_str_list C::name;
+#include <GenericFactory/HashedName.h>
+#include <GenericFactory/LiteralStringList.h>
+#include <GenericFactory/Property.h>
+
+#include <type_traits>
+
+int Lazy::registered = 0;
+
+// Composed names have to hash like the flat string they spell.
+static_assert(D<D<A> >::name.hash() == genericfactory::hashName("A_ofD_ofD"),
+    "FixedString::hash() differs from hashName()");
+static_assert(D<D<A> >::name.view() == "A_ofD_ofD",
+    "FixedString doesnt concatenate while compiling");
+// literal_str_list names still work and hash the same.
+constexpr literal_str_list kLiteralA = "A";
+static_assert((kLiteralA + "_ofD").hash() == D<A>::name.hash(),
+    "literal_str_list::hash() differs from hashName()");
+static_assert(B::name.hash() != D<B>::name.hash(),
+    "B and B_ofD should not collide");
+static_assert(
+    std::is_trivially_copyable<genericfactory::PropertyHandle<A> >::value,
+    "PropertyHandle should be cheap to copy");
@@ -24,15 +24,18 @@
 #ifndef TESTCLASSES_H_
 #define TESTCLASSES_H_
 
-#include <GenericFactory/LiteralStringList.h>
+#include <GenericFactory/FixedString.h>
+#include <GenericFactory/StaticFactory.h>
 
 #include <string>
+#include <tuple>
+#include <utility>
 
 #include "./ExampleHeader.h"
 
 struct A {
  public:
-  static constexpr literal_str_list name = "A";
+  static constexpr genericfactory::FixedString name = "A";
   static void registerProperties();
   virtual void printMe() {
     printf("me A\n");
@@ -43,7 +46,7 @@ struct A {
 };
 struct B : public A {
  public:
-  static constexpr literal_str_list name = "B";
+  static constexpr genericfactory::FixedString name = "B";
   static void registerProperties();
   virtual void printMe() {
     printf("me B\n");
@@ -57,10 +60,32 @@ struct B : public A {
     printf("Got called with %s.\n", s.c_str());
   }
   std::string basicGet() const { return "Get Called"; }
+  // For StaticFactory, GenericFactory gets them from registerProperties().
+  static constexpr auto properties = std::make_tuple(
+        genericfactory::staticProperty("basic", &B::basicSet, &B::basicGet));
+};
+// Doesnt override create(), the factory doesnt need it.
+struct E : public B {
+ public:
+  static constexpr genericfactory::FixedString name = "E";
+  virtual void printMe() {
+    printf("me E\n");
+  }
+
+  void setLevel(int level) {
+    m_Level = level;
+  }
+  int getLevel() const { return m_Level; }
+  // StaticFactory adds "basic" of B.
+  static constexpr auto properties = std::make_tuple(
+        genericfactory::staticProperty("level", &E::setLevel, &E::getLevel));
+
+ private:
+  int m_Level = 0;
 };
 struct C {
  public:
-  static constexpr literal_str_list name = "C";
+  static constexpr genericfactory::FixedString name = "C";
   virtual void printMe() {
     printf("me C\n");
   }
@@ -69,10 +94,109 @@ struct C {
   }*/
 };
 
+// Used by the stress test, doesnt print anything.
+struct Counter : public A {
+ public:
+  static constexpr genericfactory::FixedString name = "Counter";
+  static void registerProperties();
+  virtual void test() { }
+  virtual Counter* create() const {
+    return new Counter();
+  }
+
+  void setCount(float count) {
+    m_Count = count;
+  }
+  float getCount() const { return m_Count; }
+  // Taken and returned by reference.
+  void setLabel(const std::string& label) {
+    m_Label = label;
+  }
+  const std::string& getLabel() const { return m_Label; }
+  void setTag(std::string&& tag) {
+    m_Tag = std::move(tag);
+  }
+  std::string getTag() const { return m_Tag; }
+
+  // Registered as data member, without setter/getter.
+  int hits = 0;
+
+ private:
+  float m_Count = 0.0f;
+  std::string m_Label;
+  std::string m_Tag;
+};
+
+// Throws from the constructor once built counts down to 0, counts the
+// living objects.
+struct Fragile : public A {
+ public:
+  static constexpr genericfactory::FixedString name = "Fragile";
+  Fragile() {
+    if (!built--)
+      throw 1;
+    ++living;
+  }
+  virtual ~Fragile() {
+    --living;
+  }
+  virtual void test() { }
+  virtual Fragile* create() const {
+    return new Fragile();
+  }
+
+  static inline int built = 0;
+  static inline int living = 0;
+};
+
+// Registered with registerClassLazy(), counts how often its properties are
+// registered.
+struct Lazy : public A {
+ public:
+  static constexpr genericfactory::FixedString name = "Lazy";
+  static void registerProperties();
+  static int registered;
+  virtual void test() { }
+  virtual Lazy* create() const {
+    return new Lazy();
+  }
+
+  void setValue(int value) {
+    m_Value = value;
+  }
+  int getValue() const { return m_Value; }
+
+ private:
+  int m_Value = 0;
+};
+
+// Both register "x". Leaf is registered first, its "x" has to win anyway.
+struct Mid : public A {
+ public:
+  static constexpr genericfactory::FixedString name = "Mid";
+  static void registerProperties();
+  virtual void test() { }
+  virtual Mid* create() const {
+    return new Mid();
+  }
+
+  int m = 0;
+};
+struct Leaf : public Mid {
+ public:
+  static constexpr genericfactory::FixedString name = "Leaf";
+  static void registerProperties();
+  virtual Leaf* create() const {
+    return new Leaf();
+  }
+
+  int l = 0;
+};
+
 template<typename T>
 struct D : public T {
  public:
-  static constexpr literal_str_list name = T::name + "_ofD";
+  static constexpr auto name = T::name + "_ofD";
   virtual void printMe() override;
   virtual D<T>* create() const;
   virtual void test() { }
@@ -81,9 +205,6 @@ struct D : public T {
   }
   float getTest() const { return 0.0f; }
 };
-template<typename T>
-constexpr literal_str_list D<T>::name;
-
 template<typename T>
 D<T>* D<T>::create() const {
   return new D<T>();
@@ -91,7 +212,7 @@ D<T>* D<T>::create() const {
 
 template<typename T>
 void D<T>::printMe() {
-  printf("me %s\n", convert_to_string(D<T>::name).c_str());
+  printf("me %s\n", D<T>::name.c_str());
 }
 
 #endif  // TESTCLASSES_H_